@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -59,15 +59,50 @@ uintptr_t page_align(uintptr_t value, unsigned dir)
 	return value;
 }
 
+#if TRUSTED_BOARD_BOOT && AUTH_IN_PLACE
+/*******************************************************************************
+ * Internal function to authenticate an image directly from its source, when it
+ * can be read in memory, and then copy it to its load address. The copy is
+ * skipped for an image executed in place, whose load address is its source.
+ *
+ * Returns -ENODEV if the image is not memory mapped, -EAUTH if the
+ * authentication failed, in which case nothing is copied.
+ ******************************************************************************/
+static int auth_image_in_place(unsigned int image_id, uintptr_t image_handle,
+			       image_info_t *image_data)
+{
+	uintptr_t image_src;
+
+	if (io_map(image_handle, &image_src) != 0) {
+		return -ENODEV;
+	}
+
+	if (auth_mod_verify_img(image_id, (void *)image_src,
+				image_data->image_size) != 0) {
+		return -EAUTH;
+	}
+
+	if (image_src != image_data->image_base) {
+		(void)memmove((void *)image_data->image_base,
+			      (const void *)image_src, image_data->image_size);
+	}
+
+	return 0;
+}
+#endif /* TRUSTED_BOARD_BOOT && AUTH_IN_PLACE */
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
  * an image ID and extents of free memory.
  *
- * If the load is successful then the image information is updated.
+ * If the load is successful then the image information is updated. If
+ * 'authenticated' is not NULL, the image may also be authenticated while it is
+ * loaded, in which case it is set to true.
  *
  * Returns 0 on success, a negative error code otherwise.
  ******************************************************************************/
-static int load_image(unsigned int image_id, image_info_t *image_data)
+static int load_image(unsigned int image_id, image_info_t *image_data,
+		      bool *authenticated)
 {
 	uintptr_t dev_handle;
 	uintptr_t image_handle;
@@ -121,6 +156,22 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	 */
 	image_data->image_size = (uint32_t)image_size;
 
+#if TRUSTED_BOARD_BOOT && AUTH_IN_PLACE
+	if (authenticated != NULL) {
+		io_result = auth_image_in_place(image_id, image_handle,
+						image_data);
+		if (io_result != -ENODEV) {
+			if (io_result == 0) {
+				*authenticated = true;
+				INFO("Image id=%u authenticated in place: "
+				     "0x%lx - 0x%lx\n", image_id, image_base,
+				     (uintptr_t)(image_base + image_size));
+			}
+			goto exit;
+		}
+	}
+#endif
+
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
@@ -154,6 +205,7 @@ static int load_auth_image_recursive(unsigned int image_id,
 {
 	int rc;
 	unsigned int parent_id;
+	bool authenticated = false;
 
 	/* Use recursion to authenticate parent images */
 	rc = auth_mod_get_parent_id(image_id, &parent_id);
@@ -164,9 +216,9 @@ static int load_auth_image_recursive(unsigned int image_id,
 		}
 	}
 
-	/* Load the image */
-	rc = load_image(image_id, image_data);
-	if (rc != 0) {
+	/* Load the image, it may also be authenticated in the process */
+	rc = load_image(image_id, image_data, &authenticated);
+	if ((rc != 0) || authenticated) {
 		return rc;
 	}
 
@@ -196,7 +248,7 @@ static int load_auth_image_internal(unsigned int image_id,
 	}
 #endif
 
-	return load_image(image_id, image_data);
+	return load_image(image_id, image_data, NULL);
 }
 
 /*******************************************************************************
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,73 @@
 #include <common/debug.h>
 #include <common/tf_crc32.h>
 
+/*
+ * Buffers of at least CRC32_STREAMS blocks are processed as that many
+ * independent streams, one per block, so that the CRC instructions of the
+ * streams overlap in the pipeline instead of waiting on each other's result.
+ * The stream CRCs are then combined by shifting each of them over the blocks
+ * that follow it.
+ */
+#define CRC32_STREAMS		3U
+#define CRC32_BLOCK_SIZE	4096U
+
+/*
+ * x^(8 * CRC32_BLOCK_SIZE - 33) mod P, bit-reflected. Multiplying a CRC by it
+ * and reducing the 64-bit product with a CRC instruction shifts the CRC over
+ * CRC32_BLOCK_SIZE zero bytes (the product of two reflected values has one
+ * extra factor of x, and the reduction another 32).
+ */
+#define CRC32_BLOCK_SHIFT	0x68c0a2c5U
+
+/* Carry-less multiplication of two 32-bit values */
+static uint64_t crc32_clmul(uint32_t a, uint32_t b)
+{
+	uint64_t res = 0ULL;
+	unsigned int i;
+
+	for (i = 0U; i < 32U; i++) {
+		res ^= ((uint64_t)a << i) & (0ULL - (uint64_t)((b >> i) & 1U));
+	}
+
+	return res;
+}
+
+/* Advance the CRC over CRC32_BLOCK_SIZE zero bytes */
+static uint32_t crc32_shift_block(uint32_t crc)
+{
+	return __crc32d(0U, crc32_clmul(crc, CRC32_BLOCK_SHIFT));
+}
+
+/* Process 8 byte aligned data, a multiple of 8 bytes long */
+static uint32_t crc32_words(uint32_t crc, const uint64_t *buf, size_t words)
+{
+	while (words != 0UL) {
+		crc = __crc32d(crc, *buf);
+		buf++;
+		words--;
+	}
+
+	return crc;
+}
+
+/* Process CRC32_STREAMS blocks of 8 byte aligned data */
+static uint32_t crc32_streams(uint32_t crc, const uint64_t *buf)
+{
+	const size_t words = CRC32_BLOCK_SIZE / sizeof(uint64_t);
+	uint32_t crc1 = 0U, crc2 = 0U;
+	size_t i;
+
+	for (i = 0UL; i < words; i++) {
+		crc = __crc32d(crc, buf[i]);
+		crc1 = __crc32d(crc1, buf[words + i]);
+		crc2 = __crc32d(crc2, buf[(2UL * words) + i]);
+	}
+
+	crc = crc32_shift_block(crc) ^ crc1;
+
+	return crc32_shift_block(crc) ^ crc2;
+}
+
 /* compute CRC using Arm intrinsic function
  *
  * This function is useful for the platforms with the CPU ARMv8.0
@@ -18,6 +85,9 @@
  * Platforms with CPU ARMv8.0 should make sure to add a compile switch
  * '-march=armv8-a+crc" for successful compilation of this file.
  *
+ * The buffer is processed 8 bytes at a time once aligned, with interleaved
+ * streams for large buffers. Only aligned accesses are made.
+ *
  * @crc: previous accumulated CRC
  * @buf: buffer base address
  * @size: the size of the buffer
@@ -31,9 +101,34 @@ uint32_t tf_crc32(uint32_t crc, const unsigned char *buf, size_t size)
 	uint32_t calc_crc = ~crc;
 	const unsigned char *local_buf = buf;
 	size_t local_size = size;
+	size_t words;
+
+	/*
+	 * calculate CRC over byte data up to the first 8 byte boundary
+	 */
+	while ((local_size != 0UL) &&
+	       (((uintptr_t)local_buf & (sizeof(uint64_t) - 1U)) != 0UL)) {
+		calc_crc = __crc32b(calc_crc, *local_buf);
+		local_buf++;
+		local_size--;
+	}
+
+	/*
+	 * calculate CRC over blocks, then 8 byte words of data
+	 */
+	while (local_size >= (CRC32_STREAMS * CRC32_BLOCK_SIZE)) {
+		calc_crc = crc32_streams(calc_crc, (const uint64_t *)local_buf);
+		local_buf += CRC32_STREAMS * CRC32_BLOCK_SIZE;
+		local_size -= CRC32_STREAMS * CRC32_BLOCK_SIZE;
+	}
+
+	words = local_size / sizeof(uint64_t);
+	calc_crc = crc32_words(calc_crc, (const uint64_t *)local_buf, words);
+	local_buf += words * sizeof(uint64_t);
+	local_size -= words * sizeof(uint64_t);
 
 	/*
-	 * calculate CRC over byte data
+	 * calculate CRC over the remaining byte data
 	 */
 	while (local_size != 0UL) {
 		calc_crc = __crc32b(calc_crc, *local_buf);
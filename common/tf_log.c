@@ -7,13 +7,168 @@
 #include <stdarg.h>
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <common/debug.h>
+#include <drivers/console.h>
 #include <plat/common/platform.h>
+#if ENABLE_TOKENIZED_LOG
+#include <lib/cassert.h>
+#include <lib/utils.h>
+
+#include <platform_def.h>
+#endif
 
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
 static unsigned int max_log_level = LOG_LEVEL;
 
+#if ENABLE_TOKENIZED_LOG
+#ifndef PLAT_LOG_TOKEN_BUFFER_SIZE
+#define PLAT_LOG_TOKEN_BUFFER_SIZE	U(2048)
+#endif
+
+#define TF_LOG_BUF_WORDS	(PLAT_LOG_TOKEN_BUFFER_SIZE / sizeof(uint32_t))
+
+CASSERT(IS_POWER_OF_TWO(PLAT_LOG_TOKEN_BUFFER_SIZE) &&
+	(PLAT_LOG_TOKEN_BUFFER_SIZE >= U(512)),
+	assert_log_token_buffer_size);
+
+/* Only the primary CPU runs in the boot images before BL31 */
+#if defined(IMAGE_BL31) || defined(IMAGE_BL32)
+#define TF_LOG_BUFS		PLATFORM_CORE_COUNT
+#define TF_LOG_BUF_IDX()	plat_my_core_pos()
+#else
+#define TF_LOG_BUFS		U(1)
+#define TF_LOG_BUF_IDX()	U(0)
+#endif
+
+/* Maximum length of a message formatted at runtime, including the NUL */
+#define TF_LOG_TEXT_SIZE	U(128)
+
+/*
+ * Log record: a header of two words, the token and an info word giving the
+ * log level and the number of payload words that follow. The payload is an
+ * even number of words, so that there is always room for a padding record at
+ * the end of the buffer.
+ *  - Tokenized message: each argument as a 64-bit little-endian value.
+ *  - TF_LOG_TOKEN_TEXT: the NUL terminated message, padded with NULs.
+ *  - TF_LOG_TOKEN_PAD: unused space up to the end of the buffer.
+ */
+#define TF_LOG_REC_INFO(level, words)	(((level) << 16) | (words))
+#define TF_LOG_REC_WORDS(info)		(2U + ((info) & U(0xffff)))
+
+/*
+ * Per-CPU log buffer, found in memory dumps by its magic. 'head' and 'tail'
+ * are the word indexes of the end of the newest record and of the oldest
+ * record. They only ever increase, older records are evicted as new ones are
+ * written.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t size;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t buf[TF_LOG_BUF_WORDS];
+} tf_log_buf_t;
+
+static tf_log_buf_t tf_log_bufs[TF_LOG_BUFS] = {
+	[0 ... (TF_LOG_BUFS - 1U)] = {
+		.magic = TF_LOG_BUF_MAGIC,
+		.size = TF_LOG_BUF_WORDS,
+	},
+};
+
+/*
+ * Make room for a record of 'words' words at the head of the buffer, evicting
+ * the oldest records as needed, and return where it is to be written. The
+ * record is published by advancing the head once it has been written.
+ */
+static uint32_t *tf_log_reserve(tf_log_buf_t *lb, unsigned int words)
+{
+	unsigned int pos = lb->head & (TF_LOG_BUF_WORDS - 1U);
+	unsigned int pad = 0U;
+
+	/* Records do not wrap, the space left at the end is skipped */
+	if ((pos + words) > TF_LOG_BUF_WORDS) {
+		pad = TF_LOG_BUF_WORDS - pos;
+	}
+
+	while ((lb->head + pad + words - lb->tail) > TF_LOG_BUF_WORDS) {
+		lb->tail += TF_LOG_REC_WORDS(
+			lb->buf[(lb->tail + 1U) & (TF_LOG_BUF_WORDS - 1U)]);
+	}
+
+	if (pad != 0U) {
+		lb->buf[pos] = TF_LOG_TOKEN_PAD;
+		lb->buf[pos + 1U] = TF_LOG_REC_INFO(0U, pad - 2U);
+		lb->head += pad;
+		pos = 0U;
+	}
+
+	return &lb->buf[pos];
+}
+
+/*
+ * The log function of the tokenized log macros, which should not be invoked
+ * directly. The arguments are read as register sized values, the decoder
+ * truncates them as per the format string.
+ */
+void tf_log_token(unsigned int log_level, uint32_t token, unsigned int nargs,
+		  ...)
+{
+	tf_log_buf_t *lb = &tf_log_bufs[TF_LOG_BUF_IDX()];
+	unsigned int words = 2U * nargs;
+	uint32_t *rec;
+	u_register_t arg;
+	unsigned int i;
+	va_list args;
+
+	assert((log_level > 0U) && (log_level <= LOG_LEVEL_VERBOSE));
+	assert((log_level % 10U) == 0U);
+	assert(nargs <= TF_LOG_TOKEN_MAX_ARGS);
+
+	if (log_level > max_log_level)
+		return;
+
+	if ((token == TF_LOG_TOKEN_PAD) || (token == TF_LOG_TOKEN_TEXT)) {
+		token ^= 1U;
+	}
+
+	rec = tf_log_reserve(lb, 2U + words);
+	rec[0] = token;
+	rec[1] = TF_LOG_REC_INFO(log_level, words);
+
+	va_start(args, nargs);
+	for (i = 0U; i < nargs; i++) {
+		arg = va_arg(args, u_register_t);
+		rec[2U + (2U * i)] = (uint32_t)arg;
+		rec[3U + (2U * i)] = (uint32_t)((uint64_t)arg >> 32);
+	}
+	va_end(args);
+
+	lb->head += 2U + words;
+}
+
+/* Log a message formatted at runtime as a text record */
+static void tf_log_text(unsigned int log_level, const char *text)
+{
+	tf_log_buf_t *lb = &tf_log_bufs[TF_LOG_BUF_IDX()];
+	unsigned int len = strlen(text) + 1U;
+	unsigned int words;
+	uint32_t *rec;
+
+	words = 2U * (unsigned int)div_round_up(len, 2U * sizeof(uint32_t));
+
+	rec = tf_log_reserve(lb, 2U + words);
+	rec[0] = TF_LOG_TOKEN_TEXT;
+	rec[1] = TF_LOG_REC_INFO(log_level, words);
+	zeromem(&rec[2], words * sizeof(uint32_t));
+	(void)memcpy(&rec[2], text, len);
+
+	lb->head += 2U + words;
+}
+#endif /* ENABLE_TOKENIZED_LOG */
+
 /*
  * The common log function which is invoked by TF-A code.
  * This function should not be directly invoked and is meant to be
@@ -25,7 +180,11 @@ void tf_log(const char *fmt, ...)
 {
 	unsigned int log_level;
 	va_list args;
+#if ENABLE_TOKENIZED_LOG
+	char text[TF_LOG_TEXT_SIZE];
+#else
 	const char *prefix_str;
+#endif
 
 	/* We expect the LOG_MARKER_* macro as the first character */
 	log_level = fmt[0];
@@ -37,6 +196,13 @@ void tf_log(const char *fmt, ...)
 	if (log_level > max_log_level)
 		return;
 
+#if ENABLE_TOKENIZED_LOG
+	va_start(args, fmt);
+	(void)vsnprintf(text, sizeof(text), fmt + 1, args);
+	va_end(args);
+
+	tf_log_text(log_level, text);
+#else
 	prefix_str = plat_log_get_prefix(log_level);
 
 	while (*prefix_str != '\0') {
@@ -47,6 +213,14 @@ void tf_log(const char *fmt, ...)
 	va_start(args, fmt);
 	(void)vprintf(fmt + 1, args);
 	va_end(args);
+
+	/*
+	 * Errors and warnings often precede a fatal stop that does not flush
+	 * the consoles, output them without delay.
+	 */
+	if (log_level <= LOG_LEVEL_WARNING)
+		console_log_drain();
+#endif
 }
 
 void tf_log_newline(const char log_fmt[2])
@@ -60,7 +234,14 @@ void tf_log_newline(const char log_fmt[2])
 	if (log_level > max_log_level)
 		return;
 
+#if ENABLE_TOKENIZED_LOG
+	tf_log_text(log_level, "\n");
+#else
 	putchar('\n');
+
+	if (log_level <= LOG_LEVEL_WARNING)
+		console_log_drain();
+#endif
 }
 
 /*
@@ -10,6 +10,7 @@
 
 #include <platform_def.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <common/tbbr/cot_def.h>
 #include <drivers/auth/auth_common.h>
@@ -17,6 +18,7 @@
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/img_parser_mod.h>
 #include <drivers/fwu/fwu.h>
+#include <lib/cassert.h>
 #include <lib/fconf/fconf_tbbr_getter.h>
 #include <plat/common/platform.h>
 
@@ -27,6 +29,148 @@
 
 #pragma weak plat_set_nv_ctr2
 
+/*
+ * Hash (DER encoded DigestInfo from the parent image) against which the last
+ * raw image was successfully authenticated. Measured boot can record it
+ * instead of hashing the same data a second time.
+ */
+static struct {
+	unsigned int img_id;
+	const void *data_ptr;
+	unsigned int data_len;
+	void *digest_info_ptr;
+	unsigned int digest_info_len;
+} last_img_hash = {
+	.img_id = INVALID_IMAGE_ID
+};
+
+#if AUTH_SIG_CACHE
+/*
+ * Signature verification results shared between boot stages. An entry records
+ * that the certificate whose content hashes to 'img_digest' carries a valid
+ * signature made with the public key hashing to 'pk_digest', so a later stage
+ * authenticating the same certificate can skip the public key operation.
+ * The storage is provided by the platform in memory only accessible to the
+ * boot loader images (e.g. inside BL1 RW data).
+ */
+#define AUTH_SIG_CACHE_MAGIC		U(0x43474953)	/* "SIGC" */
+
+typedef struct {
+	uint32_t img_id;
+	uint32_t reserved;
+	uint8_t img_digest[AUTH_SIG_CACHE_DIGEST_SIZE];
+	uint8_t pk_digest[AUTH_SIG_CACHE_DIGEST_SIZE];
+} auth_sig_cache_entry_t;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t num_entries;
+	auth_sig_cache_entry_t entries[];
+} auth_sig_cache_t;
+
+CASSERT(AUTH_SIG_CACHE_SIZE(0U) == sizeof(auth_sig_cache_t),
+	assert_auth_sig_cache_hdr_size_mismatch);
+CASSERT(AUTH_SIG_CACHE_ENTRY_SIZE == sizeof(auth_sig_cache_entry_t),
+	assert_auth_sig_cache_entry_size_mismatch);
+
+static auth_sig_cache_t *sig_cache;
+static unsigned int sig_cache_max_entries;
+
+static void auth_sig_cache_init(void)
+{
+	void *cache_addr;
+	size_t cache_size;
+
+	if ((plat_get_auth_sig_cache(&cache_addr, &cache_size) != 0) ||
+	    (cache_addr == NULL) ||
+	    (cache_size < AUTH_SIG_CACHE_SIZE(1U))) {
+		VERBOSE("[TBB] Signature cache not available\n");
+		return;
+	}
+
+	sig_cache = cache_addr;
+	sig_cache_max_entries = (unsigned int)((cache_size -
+		sizeof(auth_sig_cache_t)) / sizeof(auth_sig_cache_entry_t));
+
+	/*
+	 * BL1 is the first user of the cache after a reset. Later stages
+	 * only trust the contents if they were initialised by BL1.
+	 */
+#if defined(IMAGE_BL1)
+	sig_cache->magic = 0U;
+#endif
+	if ((sig_cache->magic != AUTH_SIG_CACHE_MAGIC) ||
+	    (sig_cache->num_entries > sig_cache_max_entries)) {
+		sig_cache->magic = AUTH_SIG_CACHE_MAGIC;
+		sig_cache->num_entries = 0U;
+		flush_dcache_range((uintptr_t)sig_cache,
+				   sizeof(auth_sig_cache_t));
+	}
+}
+
+/*
+ * Compute the cache entry identifying the signature check of certificate
+ * 'img_id' located at 'img' with the public key 'pk_ptr'.
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+static int auth_sig_cache_get_entry(unsigned int img_id, void *img,
+				    unsigned int img_len, void *pk_ptr,
+				    unsigned int pk_len,
+				    auth_sig_cache_entry_t *entry)
+{
+	unsigned char md[CRYPTO_MD_MAX_SIZE];
+	int rc;
+
+	entry->img_id = img_id;
+	entry->reserved = 0U;
+
+	rc = crypto_mod_calc_hash(CRYPTO_MD_SHA256, img, img_len, md);
+	if (rc != 0) {
+		return rc;
+	}
+	(void)memcpy(entry->img_digest, md, sizeof(entry->img_digest));
+
+	rc = crypto_mod_calc_hash(CRYPTO_MD_SHA256, pk_ptr, pk_len, md);
+	if (rc != 0) {
+		return rc;
+	}
+	(void)memcpy(entry->pk_digest, md, sizeof(entry->pk_digest));
+
+	return 0;
+}
+
+static bool auth_sig_cache_lookup(const auth_sig_cache_entry_t *entry)
+{
+	unsigned int i;
+
+	for (i = 0U; i < sig_cache->num_entries; i++) {
+		if (memcmp(&sig_cache->entries[i], entry,
+			   sizeof(*entry)) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void auth_sig_cache_insert(const auth_sig_cache_entry_t *entry)
+{
+	auth_sig_cache_entry_t *slot;
+
+	if (sig_cache->num_entries >= sig_cache_max_entries) {
+		return;
+	}
+
+	slot = &sig_cache->entries[sig_cache->num_entries];
+	(void)memcpy(slot, entry, sizeof(*slot));
+	flush_dcache_range((uintptr_t)slot, sizeof(*slot));
+
+	sig_cache->num_entries++;
+	flush_dcache_range((uintptr_t)sig_cache, sizeof(auth_sig_cache_t));
+}
+#endif /* AUTH_SIG_CACHE */
+
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
 {
@@ -122,6 +266,14 @@ static int auth_hash(const auth_method_param_hash_t *param,
 		return rc;
 	}
 
+	if (img_desc->img_type == IMG_RAW) {
+		last_img_hash.img_id = img_desc->img_id;
+		last_img_hash.data_ptr = data_ptr;
+		last_img_hash.data_len = data_len;
+		last_img_hash.digest_info_ptr = hash_der_ptr;
+		last_img_hash.digest_info_len = hash_der_len;
+	}
+
 	return 0;
 }
 
@@ -160,6 +312,10 @@ static int auth_signature(const auth_method_param_sig_t *param,
 	unsigned int data_len, pk_len, cnv_pk_len, pk_plat_len, sig_len, sig_alg_len;
 	unsigned int flags = 0;
 	int rc;
+#if AUTH_SIG_CACHE
+	auth_sig_cache_entry_t sig_cache_entry;
+	bool sig_cache_valid = false;
+#endif
 
 	/* Get the data to be signed from current image */
 	rc = img_parser_get_auth_param(img_desc->img_type, param->data,
@@ -288,6 +444,23 @@ static int auth_signature(const auth_method_param_sig_t *param,
 		}
 	}
 
+#if AUTH_SIG_CACHE
+	/*
+	 * Skip the public key operation if an earlier stage already verified
+	 * the signature of this exact certificate with this exact key.
+	 */
+	if (sig_cache != NULL) {
+		sig_cache_valid = (auth_sig_cache_get_entry(img_desc->img_id,
+				img, img_len, pk_ptr, pk_len,
+				&sig_cache_entry) == 0);
+		if (sig_cache_valid && auth_sig_cache_lookup(&sig_cache_entry)) {
+			VERBOSE("[TBB] Image id %u: signature found in cache\n",
+				img_desc->img_id);
+			return 0;
+		}
+	}
+#endif /* AUTH_SIG_CACHE */
+
 	/* Ask the crypto module to verify the signature */
 	rc = crypto_mod_verify_signature(data_ptr, data_len,
 					 sig_ptr, sig_len,
@@ -299,6 +472,12 @@ static int auth_signature(const auth_method_param_sig_t *param,
 		return rc;
 	}
 
+#if AUTH_SIG_CACHE
+	if (sig_cache_valid) {
+		auth_sig_cache_insert(&sig_cache_entry);
+	}
+#endif /* AUTH_SIG_CACHE */
+
 	return 0;
 }
 
@@ -442,6 +621,33 @@ void auth_mod_init(void)
 
 	/* Image parser module */
 	img_parser_init();
+
+#if AUTH_SIG_CACHE
+	auth_sig_cache_init();
+#endif
+}
+
+/*
+ * Return the DER encoded DigestInfo against which the image 'img_id' located
+ * at 'img_ptr' was authenticated, provided it is the last image that went
+ * through auth_mod_verify_img() and the whole image was covered by the hash.
+ *
+ * Return: 0 = success, Otherwise = no verified hash available
+ */
+int auth_mod_get_img_digest_info(unsigned int img_id, const void *img_ptr,
+				 unsigned int img_len, void **digest_info_ptr,
+				 unsigned int *digest_info_len)
+{
+	if ((last_img_hash.img_id != img_id) ||
+	    (last_img_hash.data_ptr != img_ptr) ||
+	    (last_img_hash.data_len != img_len)) {
+		return 1;
+	}
+
+	*digest_info_ptr = last_img_hash.digest_info_ptr;
+	*digest_info_len = last_img_hash.digest_info_len;
+
+	return 0;
 }
 
 /*
@@ -467,6 +673,9 @@ int auth_mod_verify_img(unsigned int img_id,
 	/* Get the image descriptor from the chain of trust */
 	img_desc = FCONF_GET_PROPERTY(tbbr, cot, img_id);
 
+	/* Forget the hash of the previously authenticated image */
+	last_img_hash.img_id = INVALID_IMAGE_ID;
+
 	/* Ask the parser to check the image integrity */
 	rc = img_parser_check_integrity(img_desc->img_type, img_ptr, img_len);
 	if (rc != 0) {
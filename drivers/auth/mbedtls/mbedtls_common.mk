@@ -150,12 +150,30 @@ else
     TF_MBEDTLS_USE_AES_GCM	:=	0
 endif
 
+# Replace the mbed TLS SHA-256 implementation with one that uses the Armv8
+# SHA-256 instructions
+TF_MBEDTLS_SHA256_A64	?=	0
+$(eval $(call assert_boolean,TF_MBEDTLS_SHA256_A64))
+
+ifeq (${TF_MBEDTLS_SHA256_A64},1)
+    ifneq (${ARCH},aarch64)
+        $(error "TF_MBEDTLS_SHA256_A64 is only supported on AArch64")
+    endif
+    ifneq (${MBEDTLS_MAJOR},3)
+        $(error "TF_MBEDTLS_SHA256_A64 requires mbed TLS 3.x")
+    endif
+    MBEDTLS_INC		+=	-Iinclude/drivers/auth/mbedtls/alt
+    MBEDTLS_SOURCES	+=	drivers/auth/mbedtls/mbedtls_sha256.c		\
+				drivers/auth/mbedtls/aarch64/sha256_a64.S
+endif
+
 # Needs to be set to drive mbed TLS configuration correctly
 $(eval $(call add_defines,\
     $(sort \
         TF_MBEDTLS_KEY_ALG_ID \
         TF_MBEDTLS_KEY_SIZE \
         TF_MBEDTLS_HASH_ALG_ID \
+        TF_MBEDTLS_SHA256_A64 \
         TF_MBEDTLS_USE_AES_GCM \
 )))
 
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* mbed TLS headers */
+#include <mbedtls/error.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/sha256.h>
+
+#include <arch.h>
+#include <arch_features.h>
+#include <arch_helpers.h>
+
+/*
+ * SHA-224/SHA-256 for mbed TLS (MBEDTLS_SHA256_ALT), using the Armv8 SHA-256
+ * instructions when FEAT_SHA256 is implemented. mbedtls_sha256_update()
+ * hands whole runs of blocks to the block function, so that the cost of
+ * entering the accelerated path is paid once per update rather than once per
+ * 64-byte block.
+ *
+ * TF-A is built with -mgeneral-regs-only, so the accelerated path lives in
+ * sha256_a64.S, which saves and restores the SIMD registers it uses. It is
+ * only used by the boot loader images, BL31 always uses the generic
+ * implementation.
+ */
+void sha256_a64_process_blocks(uint32_t state[8], const uint8_t *data,
+			       size_t blocks);
+
+/* Round constants, also used by sha256_a64.S */
+const uint32_t sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+	0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+	0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+	0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+	0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+	0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROTR(x, n)	(((x) >> (n)) | ((x) << (32U - (n))))
+#define S0(x)		(ROTR(x, 2U) ^ ROTR(x, 13U) ^ ROTR(x, 22U))
+#define S1(x)		(ROTR(x, 6U) ^ ROTR(x, 11U) ^ ROTR(x, 25U))
+#define s0(x)		(ROTR(x, 7U) ^ ROTR(x, 18U) ^ ((x) >> 3U))
+#define s1(x)		(ROTR(x, 17U) ^ ROTR(x, 19U) ^ ((x) >> 10U))
+#define CH(x, y, z)	(((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z)	(((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+
+static void sha256_process_block_c(uint32_t state[8], const uint8_t *data)
+{
+	uint32_t w[16];
+	uint32_t v[8];
+	uint32_t t1, t2;
+	unsigned int i;
+
+	for (i = 0U; i < 8U; i++) {
+		v[i] = state[i];
+	}
+
+	for (i = 0U; i < 64U; i++) {
+		if (i < 16U) {
+			w[i] = ((uint32_t)data[4U * i] << 24) |
+			       ((uint32_t)data[4U * i + 1U] << 16) |
+			       ((uint32_t)data[4U * i + 2U] << 8) |
+			       (uint32_t)data[4U * i + 3U];
+		} else {
+			w[i & 15U] += s1(w[(i - 2U) & 15U]) +
+				      w[(i - 7U) & 15U] +
+				      s0(w[(i - 15U) & 15U]);
+		}
+
+		t1 = v[7] + S1(v[4]) + CH(v[4], v[5], v[6]) + sha256_k[i] +
+		     w[i & 15U];
+		t2 = S0(v[0]) + MAJ(v[0], v[1], v[2]);
+
+		v[7] = v[6];
+		v[6] = v[5];
+		v[5] = v[4];
+		v[4] = v[3] + t1;
+		v[3] = v[2];
+		v[2] = v[1];
+		v[1] = v[0];
+		v[0] = t1 + t2;
+	}
+
+	for (i = 0U; i < 8U; i++) {
+		state[i] += v[i];
+	}
+}
+
+#if !IMAGE_BL31
+static void sha256_process_blocks_a64(uint32_t state[8], const uint8_t *data,
+				      size_t blocks)
+{
+	u_register_t cptr_el3 = 0U;
+	bool at_el3 = (get_current_el() == 3U);
+
+	/*
+	 * CPTR_EL3.TFP is left set by el3_arch_init_common, so FP/SIMD
+	 * accesses are trapped at EL3 until the next image is set up.
+	 */
+	if (at_el3) {
+		cptr_el3 = read_cptr_el3();
+		write_cptr_el3(cptr_el3 & ~TFP_BIT);
+		isb();
+	}
+
+	sha256_a64_process_blocks(state, data, blocks);
+
+	if (at_el3) {
+		write_cptr_el3(cptr_el3);
+		isb();
+	}
+}
+#endif
+
+static void sha256_process_blocks(uint32_t state[8], const uint8_t *data,
+				  size_t blocks)
+{
+#if !IMAGE_BL31
+	static int use_a64 = -1;
+
+	if (use_a64 < 0) {
+		use_a64 = is_feat_sha256_present() ? 1 : 0;
+	}
+
+	if (use_a64 != 0) {
+		sha256_process_blocks_a64(state, data, blocks);
+		return;
+	}
+#endif
+	for (; blocks != 0U; blocks--) {
+		sha256_process_block_c(state, data);
+		data += 64U;
+	}
+}
+
+static void put_be32(unsigned char *p, uint32_t v)
+{
+	p[0] = (unsigned char)(v >> 24);
+	p[1] = (unsigned char)(v >> 16);
+	p[2] = (unsigned char)(v >> 8);
+	p[3] = (unsigned char)v;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx)
+{
+	(void)memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx)
+{
+	if (ctx != NULL) {
+		mbedtls_platform_zeroize(ctx, sizeof(*ctx));
+	}
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context *dst,
+			  const mbedtls_sha256_context *src)
+{
+	*dst = *src;
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context *ctx, int is224)
+{
+	static const uint32_t sha256_iv[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+		0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+	};
+#if defined(MBEDTLS_SHA224_C)
+	static const uint32_t sha224_iv[8] = {
+		0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+		0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4,
+	};
+#endif
+
+	if (is224 != 0) {
+#if defined(MBEDTLS_SHA224_C)
+		(void)memcpy(ctx->state, sha224_iv, sizeof(ctx->state));
+#else
+		return MBEDTLS_ERR_SHA256_BAD_INPUT_DATA;
+#endif
+	} else {
+		(void)memcpy(ctx->state, sha256_iv, sizeof(ctx->state));
+	}
+
+	ctx->total = 0U;
+	ctx->is224 = is224;
+
+	return 0;
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
+				    const unsigned char data[64])
+{
+	sha256_process_blocks(ctx->state, data, 1U);
+
+	return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context *ctx,
+			  const unsigned char *input, size_t ilen)
+{
+	size_t left = (size_t)(ctx->total & 63U);
+	size_t blocks;
+
+	ctx->total += ilen;
+
+	/* Complete the buffered block first */
+	if ((left != 0U) && (ilen >= (64U - left))) {
+		(void)memcpy(ctx->buffer + left, input, 64U - left);
+		sha256_process_blocks(ctx->state, ctx->buffer, 1U);
+		input += 64U - left;
+		ilen -= 64U - left;
+		left = 0U;
+	}
+
+	/* Then process the whole blocks straight from the input */
+	blocks = ilen / 64U;
+	if (blocks != 0U) {
+		sha256_process_blocks(ctx->state, input, blocks);
+		input += blocks * 64U;
+		ilen -= blocks * 64U;
+	}
+
+	if (ilen != 0U) {
+		(void)memcpy(ctx->buffer + left, input, ilen);
+	}
+
+	return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context *ctx, unsigned char *output)
+{
+	size_t used = (size_t)(ctx->total & 63U);
+	uint64_t bits = ctx->total << 3;
+	unsigned int i;
+
+	ctx->buffer[used++] = 0x80U;
+
+	if (used > 56U) {
+		(void)memset(ctx->buffer + used, 0, 64U - used);
+		sha256_process_blocks(ctx->state, ctx->buffer, 1U);
+		used = 0U;
+	}
+
+	(void)memset(ctx->buffer + used, 0, 56U - used);
+	put_be32(ctx->buffer + 56U, (uint32_t)(bits >> 32));
+	put_be32(ctx->buffer + 60U, (uint32_t)bits);
+	sha256_process_blocks(ctx->state, ctx->buffer, 1U);
+
+	for (i = 0U; i < ((ctx->is224 != 0) ? 7U : 8U); i++) {
+		put_be32(output + (4U * i), ctx->state[i]);
+	}
+
+	return 0;
+}
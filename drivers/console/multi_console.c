@@ -9,10 +9,48 @@
 #include <stdlib.h>
 
 #include <drivers/console.h>
+#if ENABLE_CONSOLE_LOG_BUFFER
+#include <lib/cassert.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+#endif
 
 console_t *console_list;
 static uint8_t console_state = CONSOLE_FLAG_BOOT;
 
+#if ENABLE_CONSOLE_LOG_BUFFER
+#ifndef PLAT_CONSOLE_LOG_BUFFER_SIZE
+#define PLAT_CONSOLE_LOG_BUFFER_SIZE	U(1024)
+#endif
+
+CASSERT(IS_POWER_OF_TWO(PLAT_CONSOLE_LOG_BUFFER_SIZE),
+	assert_console_log_buffer_size_power_of_two);
+
+/* Only the primary CPU runs in the boot images before BL31 */
+#if defined(IMAGE_BL31) || defined(IMAGE_BL32)
+#define CONSOLE_LOG_RINGS		PLATFORM_CORE_COUNT
+#define CONSOLE_LOG_RING_IDX()		plat_my_core_pos()
+#else
+#define CONSOLE_LOG_RINGS		U(1)
+#define CONSOLE_LOG_RING_IDX()		U(0)
+#endif
+
+/*
+ * Per-CPU log ring. Characters are written at 'head' and output to the
+ * consoles from 'tail', both indexes only ever increase. Once output, the last
+ * PLAT_CONSOLE_LOG_BUFFER_SIZE characters stay in the ring, so that they can
+ * still be read from memory after the fact.
+ */
+typedef struct {
+	unsigned int head;
+	unsigned int tail;
+	char buf[PLAT_CONSOLE_LOG_BUFFER_SIZE];
+} console_log_t;
+
+static console_log_t console_log[CONSOLE_LOG_RINGS];
+#endif
+
 IMPORT_SYM(console_t *, __STACKS_START__, stacks_start)
 IMPORT_SYM(console_t *, __STACKS_END__, stacks_end)
 
@@ -62,6 +100,9 @@ int console_is_registered(console_t *to_find)
 
 void console_switch_state(unsigned int new_state)
 {
+	/* Output the buffered characters on the consoles of the old state */
+	console_log_drain();
+
 	console_state = new_state;
 }
 
@@ -86,7 +127,7 @@ static int do_putc(int c, console_t *console)
 	return console->putc(c, console);
 }
 
-int console_putc(int c)
+static int console_output(int c)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
@@ -100,6 +141,47 @@ int console_putc(int c)
 	return err;
 }
 
+#if ENABLE_CONSOLE_LOG_BUFFER
+static void console_log_drain_ring(console_log_t *log)
+{
+	while (log->tail != log->head) {
+		(void)console_output(log->buf[log->tail &
+					      (PLAT_CONSOLE_LOG_BUFFER_SIZE - 1U)]);
+		log->tail++;
+	}
+}
+
+void console_log_drain(void)
+{
+	console_log_drain_ring(&console_log[CONSOLE_LOG_RING_IDX()]);
+}
+
+int console_putc(int c)
+{
+	console_log_t *log;
+
+	/* Nothing is deferred once crashed */
+	if (console_state == CONSOLE_FLAG_CRASH)
+		return console_output(c);
+
+	log = &console_log[CONSOLE_LOG_RING_IDX()];
+
+	/* Make room in a full ring by outputting its content */
+	if ((log->head - log->tail) == PLAT_CONSOLE_LOG_BUFFER_SIZE)
+		console_log_drain_ring(log);
+
+	log->buf[log->head & (PLAT_CONSOLE_LOG_BUFFER_SIZE - 1U)] = (char)c;
+	log->head++;
+
+	return 0;
+}
+#else
+int console_putc(int c)
+{
+	return console_output(c);
+}
+#endif
+
 int putchar(int c)
 {
 	if (console_putc(c) == 0)
@@ -134,6 +216,8 @@ void console_flush(void)
 {
 	console_t *console;
 
+	console_log_drain();
+
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && (console->flush != NULL)) {
 			console->flush(console);
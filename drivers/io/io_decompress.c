@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <common/debug.h>
+#include <drivers/io/io_decompress.h>
+#include <drivers/io/io_driver.h>
+#include <drivers/io/io_storage.h>
+#include <plat/common/platform.h>
+
+/*
+ * Size of the buffer the compressed stream is read into. Only this much of
+ * the compressed image is held in memory at any time, the decompressed data
+ * is written directly to the destination of the read.
+ */
+#ifndef IO_DECOMPRESS_BUF_SIZE
+#define IO_DECOMPRESS_BUF_SIZE	4096U
+#endif
+
+/* Largest trailer a decompressor may ask for in get_size() */
+#define IO_DECOMPRESS_TAIL_MAX	8U
+
+static uintptr_t backend_dev_handle;
+static uintptr_t backend_dev_spec;
+static uintptr_t backend_handle;
+static uintptr_t backend_image_spec;
+
+static const io_decompressor_t *dec_ops;
+static uintptr_t dec_work_base;
+static size_t dec_work_size;
+
+/* State of the open file */
+static size_t comp_len;		/* size of the compressed stream */
+static size_t comp_pos;		/* compressed bytes read from the backend */
+static size_t dec_len;		/* size of the decompressed image */
+static size_t dec_pos;		/* decompressed bytes returned so far */
+static bool dec_done;		/* end of the compressed stream seen */
+
+static uint8_t dec_in_buf[IO_DECOMPRESS_BUF_SIZE];
+static size_t dec_in_off;
+static size_t dec_in_avail;
+
+static io_dev_info_t dec_dev_info;
+
+/* Decompression driver functions */
+static int dec_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
+static int dec_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
+			 io_entity_t *entity);
+static int dec_file_len(io_entity_t *entity, size_t *length);
+static int dec_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
+			 size_t *length_read);
+static int dec_file_close(io_entity_t *entity);
+static int dec_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params);
+static int dec_dev_close(io_dev_info_t *dev_info);
+
+static io_type_t device_type_dec(void)
+{
+	return IO_TYPE_DECOMPRESS;
+}
+
+static const io_dev_connector_t dec_dev_connector = {
+	.dev_open = dec_dev_open
+};
+
+static const io_dev_funcs_t dec_dev_funcs = {
+	.type = device_type_dec,
+	.open = dec_file_open,
+	.seek = NULL,
+	.size = dec_file_len,
+	.read = dec_file_read,
+	.write = NULL,
+	.close = dec_file_close,
+	.dev_init = dec_dev_init,
+	.dev_close = dec_dev_close,
+};
+
+static int dec_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
+{
+	assert(dev_info != NULL);
+
+	dec_dev_info.funcs = &dec_dev_funcs;
+	*dev_info = &dec_dev_info;
+
+	return 0;
+}
+
+static int dec_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
+{
+	int result;
+	unsigned int image_id = (unsigned int)init_params;
+
+	/* Obtain a reference to the image by querying the platform layer */
+	result = plat_get_image_source(image_id, &backend_dev_handle,
+				       &backend_dev_spec);
+	if (result != 0) {
+		WARN("Failed to obtain reference to image id=%u (%i)\n",
+			image_id, result);
+		return -ENOENT;
+	}
+
+	return result;
+}
+
+static int dec_dev_close(io_dev_info_t *dev_info)
+{
+	backend_dev_handle = (uintptr_t)NULL;
+	backend_dev_spec = (uintptr_t)NULL;
+
+	return 0;
+}
+
+/* Fill the input buffer with the next block of the compressed stream */
+static int dec_refill(void)
+{
+	size_t length = comp_len - comp_pos;
+	size_t bytes_read;
+	int result;
+
+	if (length == 0U) {
+		WARN("Compressed stream is truncated\n");
+		return -EIO;
+	}
+
+	if (length > sizeof(dec_in_buf)) {
+		length = sizeof(dec_in_buf);
+	}
+
+	result = io_read(backend_handle, (uintptr_t)dec_in_buf, length,
+			 &bytes_read);
+	if ((result != 0) || (bytes_read != length)) {
+		WARN("Failed to read compressed data (%i)\n", result);
+		return -EIO;
+	}
+
+	comp_pos += length;
+	dec_in_off = 0U;
+	dec_in_avail = length;
+
+	return 0;
+}
+
+/* Read the trailer of the compressed stream and rewind the backend */
+static int dec_read_tail(uint8_t *tail, size_t tail_len)
+{
+	size_t bytes_read;
+	int result;
+
+	result = io_seek(backend_handle, IO_SEEK_SET,
+			 (signed long long)(comp_len - tail_len));
+	if (result != 0) {
+		WARN("Failed to seek to compressed stream trailer (%i)\n",
+		     result);
+		return result;
+	}
+
+	result = io_read(backend_handle, (uintptr_t)tail, tail_len,
+			 &bytes_read);
+	if ((result != 0) || (bytes_read != tail_len)) {
+		WARN("Failed to read compressed stream trailer (%i)\n",
+		     result);
+		return -EIO;
+	}
+
+	return io_seek(backend_handle, IO_SEEK_SET, 0);
+}
+
+static int dec_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
+			 io_entity_t *entity)
+{
+	uint8_t tail[IO_DECOMPRESS_TAIL_MAX];
+	int result;
+
+	assert(spec != 0);
+	assert(entity != NULL);
+	assert(dec_ops != NULL);
+	assert(dec_ops->tail_len <= sizeof(tail));
+
+	backend_image_spec = spec;
+
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		WARN("Failed to open backend device (%i)\n", result);
+		return -ENOENT;
+	}
+
+	result = io_size(backend_handle, &comp_len);
+	if ((result != 0) || (comp_len <= dec_ops->tail_len)) {
+		WARN("Failed to read compressed stream length (%i)\n", result);
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	if (dec_ops->tail_len != 0U) {
+		result = dec_read_tail(tail, dec_ops->tail_len);
+		if (result != 0) {
+			result = -ENOENT;
+			goto err_close;
+		}
+	}
+
+	comp_pos = 0U;
+	result = dec_refill();
+	if (result != 0) {
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	result = dec_ops->get_size(dec_in_buf, dec_in_avail, tail, &dec_len);
+	if (result != 0) {
+		WARN("Compressed stream header check failed (%i)\n", result);
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	result = dec_ops->start(dec_work_base, dec_work_size);
+	if (result != 0) {
+		WARN("Failed to start decompressor (%i)\n", result);
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	dec_pos = 0U;
+	dec_done = false;
+	entity->info = (uintptr_t)&dec_len;
+
+	return 0;
+
+err_close:
+	io_close(backend_handle);
+	return result;
+}
+
+static int dec_file_len(io_entity_t *entity, size_t *length)
+{
+	assert(entity != NULL);
+	assert(length != NULL);
+
+	*length = dec_len;
+
+	return 0;
+}
+
+static int dec_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
+			 size_t *length_read)
+{
+	uintptr_t out = buffer;
+	size_t out_len;
+	int result;
+
+	assert(entity != NULL);
+	assert(length_read != NULL);
+
+	if (length > (dec_len - dec_pos)) {
+		length = dec_len - dec_pos;
+	}
+	out_len = length;
+
+	/*
+	 * Once the whole image has been produced, keep feeding the
+	 * decompressor until the end of the stream so that its trailer, if
+	 * any, is checked.
+	 */
+	while (!dec_done && ((out_len != 0U) || (dec_pos + length == dec_len))) {
+		uintptr_t in;
+		size_t in_avail, out_prev = out_len;
+
+		if (dec_in_avail == 0U) {
+			result = dec_refill();
+			if (result != 0) {
+				return result;
+			}
+		}
+
+		in = (uintptr_t)&dec_in_buf[dec_in_off];
+		in_avail = dec_in_avail;
+
+		result = dec_ops->run(&in, &in_avail, &out, &out_len);
+		if (result < 0) {
+			WARN("Failed to decompress image (%i)\n", result);
+			return -EIO;
+		}
+
+		/* Neither input consumed nor output produced: corrupt stream */
+		if ((result == 0) && (in_avail == dec_in_avail) &&
+		    (out_len == out_prev)) {
+			WARN("Decompressed image exceeds its declared size\n");
+			return -EIO;
+		}
+
+		dec_in_off += dec_in_avail - in_avail;
+		dec_in_avail = in_avail;
+		dec_done = (result == 1);
+	}
+
+	dec_pos += length - out_len;
+	if (dec_done && (dec_pos != dec_len)) {
+		WARN("Decompressed image size mismatch\n");
+		return -EIO;
+	}
+
+	*length_read = length - out_len;
+
+	return 0;
+}
+
+static int dec_file_close(io_entity_t *entity)
+{
+	io_close(backend_handle);
+
+	backend_image_spec = (uintptr_t)NULL;
+	entity->info = 0;
+
+	return 0;
+}
+
+/* Set the workspace and decompressor used for the images read */
+void io_decompress_init(uintptr_t work_base, size_t work_size,
+			const io_decompressor_t *decompressor)
+{
+	assert(decompressor != NULL);
+
+	dec_work_base = work_base;
+	dec_work_size = work_size;
+	dec_ops = decompressor;
+}
+
+/* Exported functions */
+
+/* Register the decompression driver with the IO abstraction */
+int register_io_dev_decompress(const io_dev_connector_t **dev_con)
+{
+	int result;
+
+	assert(dev_con != NULL);
+
+	result = io_register_device(&dec_dev_info);
+	if (result == 0)
+		*dev_con = &dec_dev_connector;
+
+	return result;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Linaro Limited. All rights reserved.
+ * Copyright (c) 2020-2023, Linaro Limited. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -28,6 +28,11 @@ static uintptr_t backend_dev_spec;
 static uintptr_t backend_handle;
 static uintptr_t backend_image_spec;
 
+/* Header and payload layout of the open file */
+static struct fw_enc_hdr enc_header;
+static size_t enc_len;
+static size_t enc_pos;
+
 static io_dev_info_t enc_dev_info;
 
 /* Encrypted firmware driver functions */
@@ -105,10 +110,48 @@ static int enc_dev_close(io_dev_info_t *dev_info)
 	return 0;
 }
 
+/*
+ * Compute the plaintext length of a chunked payload of 'length' bytes, in
+ * which each chunk of ciphertext is followed by its tag.
+ */
+static int enc_chunked_len(size_t length, size_t *plain_len)
+{
+	size_t chunk_size = (size_t)1U << FW_ENC_CHUNK_SHIFT(enc_header.flags);
+	size_t chunk_len = chunk_size + enc_header.tag_len;
+	size_t nr_chunks, last_len;
+
+	/* The chunk IV needs room for the chunk index and the last flag */
+	if ((FW_ENC_CHUNK_SHIFT(enc_header.flags) < FW_ENC_CHUNK_SHIFT_MIN) ||
+	    (FW_ENC_CHUNK_SHIFT(enc_header.flags) > FW_ENC_CHUNK_SHIFT_MAX) ||
+	    (enc_header.tag_len == 0U) || (enc_header.iv_len < 5U)) {
+		return -EINVAL;
+	}
+
+	nr_chunks = (length + chunk_len - 1U) / chunk_len;
+	if (nr_chunks == 0U) {
+		return -EINVAL;
+	}
+
+	/*
+	 * Chunks are authenticated as they are read, so an empty final chunk
+	 * (and an empty payload in particular) would never have its tag
+	 * checked.
+	 */
+	last_len = length - ((nr_chunks - 1U) * chunk_len);
+	if (last_len <= enc_header.tag_len) {
+		return -EINVAL;
+	}
+
+	*plain_len = length - (nr_chunks * enc_header.tag_len);
+
+	return 0;
+}
+
 static int enc_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 			 io_entity_t *entity)
 {
 	int result;
+	size_t length, bytes_read;
 
 	assert(spec != 0);
 	assert(entity != NULL);
@@ -119,42 +162,145 @@ static int enc_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 			 &backend_handle);
 	if (result != 0) {
 		WARN("Failed to open backend device (%i)\n", result);
+		return -ENOENT;
+	}
+
+	result = io_size(backend_handle, &length);
+	if (result != 0) {
+		WARN("Failed to read blob length (%i)\n", result);
 		result = -ENOENT;
+		goto err_close;
 	}
 
+	/*
+	 * Encryption header is attached at the beginning of the encrypted file
+	 * and is not considered a part of the payload.
+	 */
+	if (length < sizeof(struct fw_enc_hdr)) {
+		result = -EIO;
+		goto err_close;
+	}
+
+	length -= sizeof(struct fw_enc_hdr);
+
+	result = io_read(backend_handle, (uintptr_t)&enc_header,
+			 sizeof(enc_header), &bytes_read);
+	if ((result != 0) || (bytes_read != sizeof(enc_header))) {
+		WARN("Failed to read encryption header (%i)\n", result);
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	if (!is_valid_header(&enc_header)) {
+		WARN("Encryption header check failed.\n");
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	VERBOSE("Encryption header looks OK.\n");
+
+	if ((enc_header.iv_len > ENC_MAX_IV_SIZE) ||
+	    (enc_header.tag_len > ENC_MAX_TAG_SIZE)) {
+		WARN("Incorrect IV or tag length\n");
+		result = -ENOENT;
+		goto err_close;
+	}
+
+	if (FW_ENC_CHUNK_SHIFT(enc_header.flags) != 0U) {
+		result = enc_chunked_len(length, &enc_len);
+		if (result != 0) {
+			WARN("Incorrect chunked payload layout\n");
+			result = -ENOENT;
+			goto err_close;
+		}
+	} else {
+		enc_len = length;
+	}
+	enc_pos = 0U;
+
+	return 0;
+
+err_close:
+	io_close(backend_handle);
 	return result;
 }
 
 static int enc_file_len(io_entity_t *entity, size_t *length)
 {
-	int result;
-
 	assert(entity != NULL);
 	assert(length != NULL);
 
-	result = io_size(backend_handle, length);
-	if (result != 0) {
-		WARN("Failed to read blob length (%i)\n", result);
-		return -ENOENT;
-	}
+	*length = enc_len;
 
-	/*
-	 * Encryption header is attached at the beginning of the encrypted file
-	 * and is not considered a part of the payload.
-	 */
-	if (*length < sizeof(struct fw_enc_hdr))
-		return -EIO;
+	return 0;
+}
 
-	*length -= sizeof(struct fw_enc_hdr);
+/*
+ * Read and decrypt a chunked payload one chunk at a time, while the chunk is
+ * still hot in the cache. The ciphertext is read straight into its final
+ * location and each chunk is authenticated before the next one is read.
+ */
+static int enc_read_chunks(uintptr_t buffer, size_t length,
+			   size_t *length_read, const uint8_t *key,
+			   size_t key_len, unsigned int key_flags)
+{
+	unsigned int shift = FW_ENC_CHUNK_SHIFT(enc_header.flags);
+	uint8_t iv[ENC_MAX_IV_SIZE];
+	uint8_t tag[ENC_MAX_TAG_SIZE];
+	size_t len, bytes_read;
+	int result;
 
-	return result;
+	*length_read = 0U;
+
+	while ((length > 0U) && (enc_pos < enc_len)) {
+		len = MIN((size_t)1U << shift, enc_len - enc_pos);
+		if (length < len) {
+			WARN("Partial chunk read not supported\n");
+			return -EINVAL;
+		}
+
+		result = io_read(backend_handle, buffer, len, &bytes_read);
+		if ((result != 0) || (bytes_read != len)) {
+			WARN("Failed to read encrypted payload (%i)\n",
+			     result);
+			return -ENOENT;
+		}
+
+		result = io_read(backend_handle, (uintptr_t)tag,
+				 enc_header.tag_len, &bytes_read);
+		if ((result != 0) || (bytes_read != enc_header.tag_len)) {
+			WARN("Failed to read chunk tag (%i)\n", result);
+			return -ENOENT;
+		}
+
+		fw_enc_chunk_iv(iv, enc_header.iv, enc_header.iv_len,
+				(uint32_t)(enc_pos >> shift),
+				(enc_pos + len) == enc_len);
+
+		result = crypto_mod_auth_decrypt(enc_header.dec_algo,
+						 (void *)buffer, len, key,
+						 key_len, key_flags, iv,
+						 enc_header.iv_len, tag,
+						 enc_header.tag_len);
+		if (result != 0) {
+			ERROR("Chunk %lu decryption failed (%i)\n",
+			      (unsigned long)(enc_pos >> shift), result);
+			return -ENOENT;
+		}
+
+		buffer += len;
+		length -= len;
+		enc_pos += len;
+		*length_read += len;
+	}
+
+	return 0;
 }
 
 static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			 size_t *length_read)
 {
 	int result;
-	struct fw_enc_hdr header;
 	enum fw_enc_status_t fw_enc_status;
 	size_t bytes_read;
 	uint8_t key[ENC_MAX_KEY_SIZE];
@@ -165,48 +311,37 @@ static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	assert(entity != NULL);
 	assert(length_read != NULL);
 
-	result = io_read(backend_handle, (uintptr_t)&header, sizeof(header),
-			 &bytes_read);
-	if (result != 0) {
-		WARN("Failed to read encryption header (%i)\n", result);
-		return -ENOENT;
-	}
+	fw_enc_status = enc_header.flags & FW_ENC_STATUS_FLAG_MASK;
 
-	if (!is_valid_header(&header)) {
-		WARN("Encryption header check failed.\n");
+	result = plat_get_enc_key_info(fw_enc_status, key, &key_len, &key_flags,
+				       (uint8_t *)&uuid_spec->uuid,
+				       sizeof(uuid_t));
+	if (result != 0) {
+		WARN("Failed to obtain encryption key (%i)\n", result);
 		return -ENOENT;
 	}
 
-	VERBOSE("Encryption header looks OK.\n");
-	fw_enc_status = header.flags & FW_ENC_STATUS_FLAG_MASK;
-
-	if ((header.iv_len > ENC_MAX_IV_SIZE) ||
-	    (header.tag_len > ENC_MAX_TAG_SIZE)) {
-		WARN("Incorrect IV or tag length\n");
-		return -ENOENT;
+	if (FW_ENC_CHUNK_SHIFT(enc_header.flags) != 0U) {
+		result = enc_read_chunks(buffer, length, length_read, key,
+					 key_len, key_flags);
+		memset(key, 0, key_len);
+		return result;
 	}
 
 	result = io_read(backend_handle, buffer, length, &bytes_read);
 	if (result != 0) {
+		memset(key, 0, key_len);
 		WARN("Failed to read encrypted payload (%i)\n", result);
 		return -ENOENT;
 	}
 
 	*length_read = bytes_read;
 
-	result = plat_get_enc_key_info(fw_enc_status, key, &key_len, &key_flags,
-				       (uint8_t *)&uuid_spec->uuid,
-				       sizeof(uuid_t));
-	if (result != 0) {
-		WARN("Failed to obtain encryption key (%i)\n", result);
-		return -ENOENT;
-	}
-
-	result = crypto_mod_auth_decrypt(header.dec_algo,
+	result = crypto_mod_auth_decrypt(enc_header.dec_algo,
 					 (void *)buffer, *length_read, key,
-					 key_len, key_flags, header.iv,
-					 header.iv_len, header.tag,
-					 header.tag_len);
+					 key_len, key_flags, enc_header.iv,
+					 enc_header.iv_len, enc_header.tag,
+					 enc_header.tag_len);
 	memset(key, 0, key_len);
 
 	if (result != 0) {
@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_fip.h>
+#include <drivers/io/io_pool.h>
 #include <drivers/io/io_storage.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -25,6 +26,10 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+#ifndef MAX_FIP_FILES
+#define MAX_FIP_FILES		1
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -40,7 +45,7 @@ typedef struct {
 
 /*
  * Maintain dev_spec per FIP Device
- * TODO - Add backend handles and file state
+ * TODO - Add backend handles
  * per FIP device here once backends like io_memmap
  * can support multiple open files
  */
@@ -50,13 +55,14 @@ typedef struct {
 } fip_dev_state_t;
 
 /*
- * Only one file can be open across all FIP device
- * as backends like io_memmap don't support
- * multiple open files. The file state and
- * backend handle should be maintained per FIP device
- * if the same support is available in the backend
+ * Up to MAX_FIP_FILES files can be open across all FIP devices. The backend
+ * is only opened for the duration of each operation, so backends like
+ * io_memmap which don't support multiple open files can still be used.
+ * The backend handle should be maintained per FIP device if the same
+ * support is available in the backend
  */
-static fip_file_state_t current_fip_file = {0};
+static fip_file_state_t file_state_pool[MAX_FIP_FILES];
+static IO_POOL_ARRAY(fip_file_pool, file_state_pool);
 static uintptr_t backend_dev_handle;
 static uintptr_t backend_image_spec;
 
@@ -70,9 +76,12 @@ static unsigned int fip_dev_count;
 static int fip_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 			  io_entity_t *entity);
+static int fip_file_seek(io_entity_t *entity, int mode,
+			  signed long long offset);
 static int fip_file_len(io_entity_t *entity, size_t *length);
 static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			  size_t *length_read);
+static int fip_file_map(io_entity_t *entity, uintptr_t *address);
 static int fip_file_close(io_entity_t *entity);
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params);
 static int fip_dev_close(io_dev_info_t *dev_info);
@@ -110,9 +119,10 @@ static const io_dev_connector_t fip_dev_connector = {
 static const io_dev_funcs_t fip_dev_funcs = {
 	.type = device_type_fip,
 	.open = fip_file_open,
-	.seek = NULL,
+	.seek = fip_file_seek,
 	.size = fip_file_len,
 	.read = fip_file_read,
+	.map = fip_file_map,
 	.write = NULL,
 	.close = fip_file_close,
 	.dev_init = fip_dev_init,
@@ -286,6 +296,7 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 {
 	int result;
 	uintptr_t backend_handle;
+	fip_file_state_t *fp;
 	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)spec;
 	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
 	size_t bytes_read;
@@ -294,14 +305,13 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	assert(uuid_spec != NULL);
 	assert(entity != NULL);
 
-	/* Can only have one file open at a time for the moment. We need to
-	 * track state like file cursor position. We know the header lives at
-	 * offset zero, so this entry should never be zero for an active file.
-	 * When the system supports dynamic memory allocation we can allow more
-	 * than one open file at a time if needed.
+	/* Track state like file cursor position for each open file, up to
+	 * MAX_FIP_FILES at a time.
 	 */
-	if (current_fip_file.entry.offset_address != 0U) {
-		WARN("fip_file_open : Only one open file at a time.\n");
+	fp = io_pool_alloc(&fip_file_pool);
+	if (fp == NULL) {
+		WARN("fip_file_open : Only %u open files at a time.\n",
+		     (unsigned int)MAX_FIP_FILES);
 		return -ENFILE;
 	}
 
@@ -326,11 +336,11 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	found_file = 0;
 	do {
 		result = io_read(backend_handle,
-				 (uintptr_t)&current_fip_file.entry,
-				 sizeof(current_fip_file.entry),
+				 (uintptr_t)&fp->entry,
+				 sizeof(fp->entry),
 				 &bytes_read);
 		if (result == 0) {
-			if (compare_uuids(&current_fip_file.entry.uuid,
+			if (compare_uuids(&fp->entry.uuid,
 					  &uuid_spec->uuid) == 0) {
 				found_file = 1;
 			}
@@ -339,19 +349,18 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 			goto fip_file_open_close;
 		}
 	} while ((found_file == 0) &&
-			(compare_uuids(&current_fip_file.entry.uuid,
+			(compare_uuids(&fp->entry.uuid,
 				&uuid_null) != 0));
 
 	if (found_file == 1) {
 		/* All fine. Update entity info with file state and return. Set
-		 * the file position to 0. The 'current_fip_file.entry' holds
-		 * the base and size of the file.
+		 * the file position to 0. The 'fp->entry' holds the base and
+		 * size of the file.
 		 */
-		current_fip_file.file_pos = 0;
-		entity->info = (uintptr_t)&current_fip_file;
+		fp->file_pos = 0;
+		entity->info = (uintptr_t)fp;
 	} else {
 		/* Did not find the file in the FIP. */
-		current_fip_file.entry.offset_address = 0;
 		result = -ENOENT;
 	}
 
@@ -359,10 +368,38 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	io_close(backend_handle);
 
  fip_file_open_exit:
+	if (result != 0) {
+		io_pool_free(&fip_file_pool, fp);
+	}
 	return result;
 }
 
 
+/* Seek to a particular offset within a file in the package */
+static int fip_file_seek(io_entity_t *entity, int mode,
+			 signed long long offset)
+{
+	fip_file_state_t *fp;
+
+	assert(entity != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+
+	/* We only support IO_SEEK_SET for the moment. */
+	if (mode != IO_SEEK_SET) {
+		return -ENOTSUP;
+	}
+
+	fp = (fip_file_state_t *)entity->info;
+	if ((offset < 0) || ((unsigned long long)offset > fp->entry.size)) {
+		return -EINVAL;
+	}
+
+	fp->file_pos = (unsigned int)offset;
+
+	return 0;
+}
+
+
 /* Return the size of a file in package */
 static int fip_file_len(io_entity_t *entity, size_t *length)
 {
@@ -431,16 +468,64 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 }
 
 
-/* Close a file in package */
-static int fip_file_close(io_entity_t *entity)
+/* Return the address of a file in package, if the backend is memory mapped */
+static int fip_file_map(io_entity_t *entity, uintptr_t *address)
 {
-	/* Clear our current file pointer.
-	 * If we had malloc() we would free() here.
+	int result;
+	fip_file_state_t *fp;
+	size_t backend_size;
+	uintptr_t backend_handle;
+
+	assert(entity != NULL);
+	assert(address != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		WARN("Failed to open FIP (%i)\n", result);
+		return -ENOENT;
+	}
+
+	fp = (fip_file_state_t *)entity->info;
+
+	/*
+	 * The ToC entry is not authenticated, so check that the whole file
+	 * lies within the backend before handing out its address.
 	 */
-	if (current_fip_file.entry.offset_address != 0U) {
-		zeromem(&current_fip_file, sizeof(current_fip_file));
+	result = io_size(backend_handle, &backend_size);
+	if ((result == 0) && ((fp->entry.offset_address > backend_size) ||
+			      (fp->entry.size >
+			       (backend_size - fp->entry.offset_address)))) {
+		WARN("fip_file_map: file out of the FIP bounds\n");
+		result = -EINVAL;
 	}
 
+	if (result == 0) {
+		result = io_seek(backend_handle, IO_SEEK_SET,
+				 (signed long long)(fp->entry.offset_address +
+						    fp->file_pos));
+	}
+
+	if (result == 0) {
+		result = io_map(backend_handle, address);
+	}
+
+	io_close(backend_handle);
+
+	return result;
+}
+
+
+/* Close a file in package */
+static int fip_file_close(io_entity_t *entity)
+{
+	assert(entity != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+
+	/* Release the file state back to the pool. */
+	io_pool_free(&fip_file_pool, (void *)entity->info);
+
 	/* Clear the Entity info. */
 	entity->info = 0;
 
@@ -46,6 +46,7 @@ static int memmap_block_seek(io_entity_t *entity, int mode,
 static int memmap_block_len(io_entity_t *entity, size_t *length);
 static int memmap_block_read(io_entity_t *entity, uintptr_t buffer,
 			     size_t length, size_t *length_read);
+static int memmap_block_map(io_entity_t *entity, uintptr_t *address);
 static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 			      size_t length, size_t *length_written);
 static int memmap_block_close(io_entity_t *entity);
@@ -63,6 +64,7 @@ static const io_dev_funcs_t memmap_dev_funcs = {
 	.seek = memmap_block_seek,
 	.size = memmap_block_len,
 	.read = memmap_block_read,
+	.map = memmap_block_map,
 	.write = memmap_block_write,
 	.close = memmap_block_close,
 	.dev_init = NULL,
@@ -193,6 +195,22 @@ static int memmap_block_read(io_entity_t *entity, uintptr_t buffer,
 }
 
 
+/* Return the address of the file position on the memmap device */
+static int memmap_block_map(io_entity_t *entity, uintptr_t *address)
+{
+	memmap_file_state_t *fp;
+
+	assert(entity != NULL);
+	assert(address != NULL);
+
+	fp = (memmap_file_state_t *) entity->info;
+
+	*address = (uintptr_t)(fp->base + fp->file_pos);
+
+	return 0;
+}
+
+
 /* Write data to a file on the memmap device */
 static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 			      size_t length, size_t *length_written)
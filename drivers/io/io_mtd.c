@@ -28,8 +28,10 @@ io_type_t device_type_mtd(void);
 static int mtd_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		    io_entity_t *entity);
 static int mtd_seek(io_entity_t *entity, int mode, signed long long offset);
+static int mtd_size(io_entity_t *entity, size_t *length);
 static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		    size_t *length_read);
+static int mtd_map(io_entity_t *entity, uintptr_t *address);
 static int mtd_close(io_entity_t *entity);
 static int mtd_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int mtd_dev_close(io_dev_info_t *dev_info);
@@ -42,7 +44,9 @@ static const io_dev_funcs_t mtd_dev_funcs = {
 	.type		= device_type_mtd,
 	.open		= mtd_open,
 	.seek		= mtd_seek,
+	.size		= mtd_size,
 	.read		= mtd_read,
+	.map		= mtd_map,
 	.close		= mtd_close,
 	.dev_close	= mtd_dev_close,
 };
@@ -200,6 +204,23 @@ static int mtd_seek(io_entity_t *entity, int mode, signed long long offset)
 	return 0;
 }
 
+/* Return the size of the area, from its base to the end of the device */
+static int mtd_size(io_entity_t *entity, size_t *length)
+{
+	mtd_dev_state_t *cur;
+
+	assert((entity->info != (uintptr_t)NULL) && (length != NULL));
+
+	cur = (mtd_dev_state_t *)entity->info;
+	if (cur->base >= cur->size) {
+		return -EINVAL;
+	}
+
+	*length = (size_t)(cur->size - cur->base);
+
+	return 0;
+}
+
 static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		    size_t *out_length)
 {
@@ -232,6 +253,39 @@ static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	return 0;
 }
 
+/*
+ * Return the address of the current position through the memory-mapped window
+ * of the device, if it has one. The mapping is only valid until the next
+ * operation on the device.
+ */
+static int mtd_map(io_entity_t *entity, uintptr_t *address)
+{
+	mtd_dev_state_t *cur;
+	io_mtd_ops_t *ops;
+	unsigned long long offset;
+
+	assert((entity->info != (uintptr_t)NULL) && (address != NULL));
+
+	cur = (mtd_dev_state_t *)entity->info;
+	ops = &cur->dev_spec->ops;
+
+	/* Skipped bad blocks would break the contiguity of the mapping */
+	if ((ops->map == NULL) || (cur->extra_offset != 0U)) {
+		return -ENODEV;
+	}
+
+	offset = cur->base + cur->pos;
+	if (offset >= cur->size) {
+		return -EINVAL;
+	}
+
+	if (ops->map(offset, cur->size - offset, address) != 0) {
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
 static int mtd_close(io_entity_t *entity)
 {
 	entity->info = (uintptr_t)NULL;
@@ -1,18 +1,54 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <errno.h>
+#include <string.h>
 
 #include <platform_def.h>
 
+#include <common/debug.h>
 #include <drivers/io/io_driver.h>
+#include <drivers/io/io_pool.h>
 #include <drivers/io/io_semihosting.h>
 #include <drivers/io/io_storage.h>
 #include <lib/semihosting.h>
 
+#ifndef MAX_IO_SH_CACHED_FILES
+#define MAX_IO_SH_CACHED_FILES		8
+#endif
+
+/* File loaded in the cache */
+typedef struct {
+	const char *path;
+	uintptr_t base;
+	size_t length;
+} sh_cached_file_t;
+
+/* State of an open file, which is served from the cache */
+typedef struct {
+	const sh_cached_file_t *file;
+	size_t file_pos;
+} sh_file_state_t;
+
+/*
+ * The cache is enabled by giving its memory to io_dev_open(). The files are
+ * loaded in it one after the other, and are never evicted. The files which
+ * don't fit in it are read from the host as usual.
+ */
+static uintptr_t cache_base;
+static size_t cache_size;
+static size_t cache_used;
+
+static sh_cached_file_t cached_files[MAX_IO_SH_CACHED_FILES];
+static unsigned int cached_file_count;
+
+static sh_file_state_t file_state_pool[MAX_IO_HANDLES];
+static IO_POOL_ARRAY(sh_file_pool, file_state_pool);
+
 /* Identify the device type as semihosting */
 static io_type_t device_type_sh(void)
 {
@@ -29,6 +65,7 @@ static int sh_file_seek(io_entity_t *entity, int mode, signed long long offset);
 static int sh_file_len(io_entity_t *entity, size_t *length);
 static int sh_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		size_t *length_read);
+static int sh_file_map(io_entity_t *entity, uintptr_t *address);
 static int sh_file_write(io_entity_t *entity, const uintptr_t buffer,
 		size_t length, size_t *length_written);
 static int sh_file_close(io_entity_t *entity);
@@ -44,6 +81,7 @@ static const io_dev_funcs_t sh_dev_funcs = {
 	.seek = sh_file_seek,
 	.size = sh_file_len,
 	.read = sh_file_read,
+	.map = sh_file_map,
 	.write = sh_file_write,
 	.close = sh_file_close,
 	.dev_init = NULL,	/* NOP */
@@ -58,15 +96,139 @@ static io_dev_info_t sh_dev_info = {
 
 
 /* Open a connection to the semi-hosting device */
-static int sh_dev_open(const uintptr_t dev_spec __unused,
-		io_dev_info_t **dev_info)
+static int sh_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
 {
+	const io_sh_dev_spec_t *sh_spec = (const io_sh_dev_spec_t *)dev_spec;
+
 	assert(dev_info != NULL);
+
+	if (sh_spec != NULL) {
+		/* The cache cannot be moved once files are loaded in it */
+		assert((cached_file_count == 0U) ||
+		       ((sh_spec->cache_base == cache_base) &&
+			(sh_spec->cache_size == cache_size)));
+
+		cache_base = sh_spec->cache_base;
+		cache_size = sh_spec->cache_size;
+	}
+
 	*dev_info = &sh_dev_info;
 	return 0;
 }
 
 
+/* Return the state of a file served from the cache, NULL for a host file */
+static sh_file_state_t *sh_cached_state(const io_entity_t *entity)
+{
+	void *fp = (void *)entity->info;
+
+	return io_pool_contains(&sh_file_pool, fp) ? fp : NULL;
+}
+
+
+/* Look up a file in the cache */
+static const sh_cached_file_t *sh_cache_lookup(const char *path)
+{
+	for (unsigned int i = 0U; i < cached_file_count; i++) {
+		if (strcmp(cached_files[i].path, path) == 0) {
+			return &cached_files[i];
+		}
+	}
+
+	return NULL;
+}
+
+
+/*
+ * Load a whole file opened on the host in the cache, with a single read.
+ * Return -ENOSPC if it does not fit, in which case the file is untouched.
+ */
+static int sh_cache_load(const char *path, long sh_handle,
+			 const sh_cached_file_t **file_out)
+{
+	sh_cached_file_t *file;
+	long sh_result;
+	size_t length, bytes;
+
+	if (cached_file_count == MAX_IO_SH_CACHED_FILES) {
+		return -ENOSPC;
+	}
+
+	sh_result = semihosting_file_length(sh_handle);
+	if (sh_result < 0) {
+		return -ENOENT;
+	}
+
+	length = (size_t)sh_result;
+	if (length > (cache_size - cache_used)) {
+		return -ENOSPC;
+	}
+
+	bytes = length;
+	if (length != 0U) {
+		sh_result = semihosting_file_read(sh_handle, &bytes,
+						  cache_base + cache_used);
+		if ((sh_result != 0) || (bytes != length)) {
+			return -ENOENT;
+		}
+	}
+
+	file = &cached_files[cached_file_count];
+	file->path = path;
+	file->base = cache_base + cache_used;
+	file->length = bytes;
+
+	cached_file_count++;
+	cache_used += bytes;
+
+	VERBOSE("SH: cached %s (%zu bytes), %lu traps so far\n", path, bytes,
+		semihosting_trap_count());
+
+	*file_out = file;
+	return 0;
+}
+
+
+/* Open a file for reading from the cache, loading it first if needed */
+static int sh_cache_open(const io_file_spec_t *file_spec, io_entity_t *entity)
+{
+	const sh_cached_file_t *file = sh_cache_lookup(file_spec->path);
+	sh_file_state_t *fp;
+	long sh_handle;
+	int result;
+
+	if (file == NULL) {
+		sh_handle = semihosting_file_open(file_spec->path,
+						  file_spec->mode);
+		if (sh_handle <= 0) {
+			return -ENOENT;
+		}
+
+		result = sh_cache_load(file_spec->path, sh_handle, &file);
+		if (result == -ENOSPC) {
+			/* Read the file from the host instead */
+			entity->info = (uintptr_t)sh_handle;
+			return 0;
+		}
+
+		(void)semihosting_file_close(sh_handle);
+		if (result != 0) {
+			return result;
+		}
+	}
+
+	/* There is a file state for each IO handle */
+	fp = io_pool_alloc(&sh_file_pool);
+	assert(fp != NULL);
+
+	fp->file = file;
+	fp->file_pos = 0U;
+	entity->info = (uintptr_t)fp;
+
+	return 0;
+}
+
+
 /* Open a file on the semi-hosting device */
 static int sh_file_open(io_dev_info_t *dev_info __unused,
 		const uintptr_t spec, io_entity_t *entity)
@@ -78,6 +240,11 @@ static int sh_file_open(io_dev_info_t *dev_info __unused,
 	assert(file_spec != NULL);
 	assert(entity != NULL);
 
+	if ((cache_size != 0U) && ((file_spec->mode == FOPEN_MODE_R) ||
+				   (file_spec->mode == FOPEN_MODE_RB))) {
+		return sh_cache_open(file_spec, entity);
+	}
+
 	sh_result = semihosting_file_open(file_spec->path, file_spec->mode);
 
 	if (sh_result > 0) {
@@ -92,9 +259,20 @@ static int sh_file_open(io_dev_info_t *dev_info __unused,
 static int sh_file_seek(io_entity_t *entity, int mode, signed long long offset)
 {
 	long file_handle, sh_result;
+	sh_file_state_t *fp;
 
 	assert(entity != NULL);
 
+	fp = sh_cached_state(entity);
+	if (fp != NULL) {
+		if ((offset < 0) ||
+		    ((unsigned long long)offset > fp->file->length)) {
+			return -EINVAL;
+		}
+		fp->file_pos = (size_t)offset;
+		return 0;
+	}
+
 	file_handle = (long)entity->info;
 
 	sh_result = semihosting_file_seek(file_handle, (ssize_t)offset);
@@ -107,10 +285,17 @@ static int sh_file_seek(io_entity_t *entity, int mode, signed long long offset)
 static int sh_file_len(io_entity_t *entity, size_t *length)
 {
 	int result = -ENOENT;
+	const sh_file_state_t *fp;
 
 	assert(entity != NULL);
 	assert(length != NULL);
 
+	fp = sh_cached_state(entity);
+	if (fp != NULL) {
+		*length = fp->file->length;
+		return 0;
+	}
+
 	long sh_handle = (long)entity->info;
 	long sh_result = semihosting_file_length(sh_handle);
 
@@ -131,10 +316,22 @@ static int sh_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	long sh_result;
 	size_t bytes = length;
 	long file_handle;
+	sh_file_state_t *fp;
 
 	assert(entity != NULL);
 	assert(length_read != NULL);
 
+	fp = sh_cached_state(entity);
+	if (fp != NULL) {
+		bytes = MIN(length, fp->file->length - fp->file_pos);
+		(void)memcpy((void *)buffer,
+			     (const void *)(fp->file->base + fp->file_pos),
+			     bytes);
+		fp->file_pos += bytes;
+		*length_read = bytes;
+		return 0;
+	}
+
 	file_handle = (long)entity->info;
 
 	sh_result = semihosting_file_read(file_handle, &bytes, buffer);
@@ -148,6 +345,25 @@ static int sh_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 }
 
 
+/* Return the address of a file served from the cache */
+static int sh_file_map(io_entity_t *entity, uintptr_t *address)
+{
+	const sh_file_state_t *fp;
+
+	assert(entity != NULL);
+	assert(address != NULL);
+
+	fp = sh_cached_state(entity);
+	if (fp == NULL) {
+		return -ENODEV;
+	}
+
+	*address = fp->file->base + fp->file_pos;
+
+	return 0;
+}
+
+
 /* Write data to a file on the semi-hosting device */
 static int sh_file_write(io_entity_t *entity, const uintptr_t buffer,
 		size_t length, size_t *length_written)
@@ -159,6 +375,11 @@ static int sh_file_write(io_entity_t *entity, const uintptr_t buffer,
 	assert(entity != NULL);
 	assert(length_written != NULL);
 
+	/* The cached files are only opened for reading */
+	if (sh_cached_state(entity) != NULL) {
+		return -EPERM;
+	}
+
 	file_handle = (long)entity->info;
 
 	sh_result = semihosting_file_write(file_handle, &bytes, buffer);
@@ -174,9 +395,16 @@ static int sh_file_close(io_entity_t *entity)
 {
 	long sh_result;
 	long file_handle;
+	sh_file_state_t *fp;
 
 	assert(entity != NULL);
 
+	fp = sh_cached_state(entity);
+	if (fp != NULL) {
+		io_pool_free(&sh_file_pool, fp);
+		return 0;
+	}
+
 	file_handle = (long)entity->info;
 
 	sh_result = semihosting_file_close(file_handle);
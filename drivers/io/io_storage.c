@@ -10,17 +10,14 @@
 #include <platform_def.h>
 
 #include <drivers/io/io_driver.h>
+#include <drivers/io/io_pool.h>
 #include <drivers/io/io_storage.h>
 
 /* Storage for a fixed maximum number of IO entities, definable by platform */
 static io_entity_t entity_pool[MAX_IO_HANDLES];
 
-/* Simple way of tracking used storage - each entry is NULL or a pointer to an
- * entity */
-static io_entity_t *entity_map[MAX_IO_HANDLES];
-
-/* Track number of allocated entities */
-static unsigned int entity_count;
+/* Allocator of the entities, in constant time */
+static IO_POOL_ARRAY(entity_objects, entity_pool);
 
 /* Array of fixed maximum of registered devices, definable by platform */
 static const io_dev_info_t *devices[MAX_IO_DEVICES];
@@ -54,6 +51,7 @@ static bool is_valid_entity(const uintptr_t handle)
 	const io_entity_t *entity = (io_entity_t *)handle;
 
 	return (entity != NULL) &&
+			io_pool_is_allocated(&entity_objects, entity) &&
 			(is_valid_dev((uintptr_t)entity->dev_handle));
 }
 
@@ -88,54 +86,23 @@ static void set_handle(uintptr_t *handle, io_entity_t *entity)
 }
 
 
-/* Locate an entity in the pool, specified by address */
-static int find_first_entity(const io_entity_t *entity, unsigned int *index_out)
-{
-	int result = -ENOENT;
-	for (unsigned int index = 0; index < MAX_IO_HANDLES; ++index) {
-		if (entity_map[index] == entity) {
-			result = 0;
-			*index_out = index;
-			break;
-		}
-	}
-	return result;
-}
-
-
 /* Allocate an entity from the pool and return a pointer to it */
 static int allocate_entity(io_entity_t **entity)
 {
-	int result = -ENOMEM;
 	assert(entity != NULL);
 
-	if (entity_count < MAX_IO_HANDLES) {
-		unsigned int index = 0;
-		result = find_first_entity(NULL, &index);
-		assert(result == 0);
-		*entity = &entity_pool[index];
-		entity_map[index] = &entity_pool[index];
-		++entity_count;
-	}
+	*entity = io_pool_alloc(&entity_objects);
 
-	return result;
+	return (*entity != NULL) ? 0 : -ENOMEM;
 }
 
 
 /* Release an entity back to the pool */
-static int free_entity(const io_entity_t *entity)
+static void free_entity(io_entity_t *entity)
 {
-	int result;
-	unsigned int index = 0;
 	assert(entity != NULL);
 
-	result = find_first_entity(entity, &index);
-	if (result ==  0) {
-		entity_map[index] = NULL;
-		--entity_count;
-	}
-
-	return result;
+	io_pool_free(&entity_objects, entity);
 }
 
 
@@ -285,6 +252,23 @@ int io_read(uintptr_t handle,
 }
 
 
+/* Get the address of an IO entity in memory */
+int io_map(uintptr_t handle, uintptr_t *address)
+{
+	int result = -ENODEV;
+	assert(is_valid_entity(handle) && (address != NULL));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->map != NULL)
+		result = dev->funcs->map(entity, address);
+
+	return result;
+}
+
+
 /* Write data to an IO entity */
 int io_write(uintptr_t handle,
 		const uintptr_t buffer,
@@ -315,14 +299,20 @@ int io_close(uintptr_t handle)
 
 	io_entity_t *entity = (io_entity_t *)handle;
 
+	/*
+	 * Ignore the closing of an entity that is not open (e.g. closed
+	 * twice): its first word links it in the pool free list.
+	 */
+	if (!io_pool_is_allocated(&entity_objects, entity))
+		return -EINVAL;
+
 	io_dev_info_t *dev = entity->dev_handle;
 
 	/* Absence of registered function implies NOP here */
 	if (dev->funcs->close != NULL)
 		result = dev->funcs->close(entity);
 
-	/* Ignore improbable free_entity failure */
-	(void)free_entity(entity);
+	free_entity(entity);
 
 	return result;
 }
@@ -6,20 +6,35 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 #include <arch_helpers.h>
 
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <drivers/auth/auth_mod.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/measured_boot/event_log/event_log.h>
 
+/*
+ * DER encoding of the DigestInfo header preceding a digest of the Event Log
+ * algorithm, as listed in RFC 8017 section 9.2.
+ */
 #if TPM_ALG_ID == TPM_ALG_SHA512
 #define	CRYPTO_MD_ID	CRYPTO_MD_SHA512
+#define DIGEST_INFO_HDR	0x30, 0x51, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, \
+			0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03, 0x05, \
+			0x00, 0x04, 0x40
 #elif TPM_ALG_ID == TPM_ALG_SHA384
 #define	CRYPTO_MD_ID	CRYPTO_MD_SHA384
+#define DIGEST_INFO_HDR	0x30, 0x41, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, \
+			0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x02, 0x05, \
+			0x00, 0x04, 0x30
 #elif TPM_ALG_ID == TPM_ALG_SHA256
 #define	CRYPTO_MD_ID	CRYPTO_MD_SHA256
+#define DIGEST_INFO_HDR	0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, \
+			0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, \
+			0x00, 0x04, 0x20
 #else
 #  error Invalid TPM algorithm.
 #endif /* TPM_ALG_ID */
@@ -30,6 +45,16 @@ static uint8_t *log_ptr;
 /* Pointer to the first byte past end of the Event Log buffer */
 static uintptr_t log_end;
 
+/* Event Log usage counters */
+static event_log_stats_t log_stats;
+
+/* The authentication module is only part of the image loading stages */
+#if TRUSTED_BOARD_BOOT && (defined(IMAGE_BL1) || defined(IMAGE_BL2))
+#define EVLOG_REUSE_AUTH_HASH	1
+#else
+#define EVLOG_REUSE_AUTH_HASH	0
+#endif
+
 /* TCG_EfiSpecIdEvent */
 static const id_event_headers_t id_event_header = {
 	.header = {
@@ -145,6 +170,8 @@ void event_log_record(const uint8_t *hash, uint32_t event_type,
 	/* End of event data */
 	log_ptr = (uint8_t *)((uintptr_t)ptr +
 			offsetof(event2_data_t, event) + name_len);
+
+	log_stats.events_recorded++;
 }
 
 void event_log_buf_init(uint8_t *event_log_start, uint8_t *event_log_finish)
@@ -154,6 +181,7 @@ void event_log_buf_init(uint8_t *event_log_start, uint8_t *event_log_finish)
 
 	log_ptr = event_log_start;
 	log_end = (uintptr_t)event_log_finish;
+	log_stats = (event_log_stats_t){ 0 };
 }
 
 /*
@@ -255,15 +283,85 @@ void event_log_write_header(void)
 int event_log_measure(uintptr_t data_base, uint32_t data_size,
 		      unsigned char hash_data[CRYPTO_MD_MAX_SIZE])
 {
+	log_stats.bytes_hashed += data_size;
+
 	/* Calculate hash */
 	return crypto_mod_calc_hash(CRYPTO_MD_ID,
 				    (void *)data_base, data_size, hash_data);
 }
 
+#if EVLOG_REUSE_AUTH_HASH
+/*
+ * Look for a digest of the data computed by the authentication module while
+ * verifying it. It can only be reused if it covers exactly the same data and
+ * was computed with the Event Log hash algorithm.
+ *
+ * @param[in]  data_base	Address of data
+ * @param[in]  data_size	Size of data
+ * @param[in]  data_id		Data ID
+ * @param[out] hash_data	Digest of the data
+ * @return:
+ *	true if 'hash_data' holds a digest of the data
+ */
+static bool event_log_get_verified_hash(uintptr_t data_base,
+					uint32_t data_size, uint32_t data_id,
+					unsigned char hash_data[CRYPTO_MD_MAX_SIZE])
+{
+	static const uint8_t digest_info_hdr[] = { DIGEST_INFO_HDR };
+	void *digest_info;
+	unsigned int digest_info_len;
+
+	if (auth_mod_get_img_digest_info(data_id, (const void *)data_base,
+					 data_size, &digest_info,
+					 &digest_info_len) != 0) {
+		return false;
+	}
+
+	if ((digest_info_len < (sizeof(digest_info_hdr) + TCG_DIGEST_SIZE)) ||
+	    (memcmp(digest_info, digest_info_hdr,
+		    sizeof(digest_info_hdr)) != 0)) {
+		return false;
+	}
+
+	(void)memcpy(hash_data,
+		     (const uint8_t *)digest_info + sizeof(digest_info_hdr),
+		     TCG_DIGEST_SIZE);
+
+	return true;
+}
+#endif /* EVLOG_REUSE_AUTH_HASH */
+
+/*
+ * Write a digest computed earlier in the load path to Event Log.
+ *
+ * @param[in] hash_data		Digest of the data, computed with the Event
+ *				Log hash algorithm (TCG_DIGEST_SIZE bytes)
+ * @param[in] data_id		Data ID
+ * @param[in] metadata_ptr	Event Log metadata
+ */
+void event_log_record_hash(const unsigned char *hash_data, uint32_t data_id,
+			   const event_log_metadata_t *metadata_ptr)
+{
+	assert(hash_data != NULL);
+	assert(metadata_ptr != NULL);
+
+	/* Get the metadata associated with this image. */
+	while ((metadata_ptr->id != EVLOG_INVALID_ID) &&
+		(metadata_ptr->id != data_id)) {
+		metadata_ptr++;
+	}
+	assert(metadata_ptr->id != EVLOG_INVALID_ID);
+
+	event_log_record(hash_data, EV_POST_CODE, metadata_ptr);
+}
+
 /*
  * Calculate and write hash of image, configuration data, etc.
  * to Event Log.
  *
+ * If the data has just been authenticated against a hash of the Event Log
+ * algorithm, that hash is recorded instead of hashing the data again.
+ *
  * @param[in] data_base		Address of data
  * @param[in] data_size		Size of data
  * @param[in] data_id		Data ID
@@ -281,12 +379,14 @@ int event_log_measure_and_record(uintptr_t data_base, uint32_t data_size,
 
 	assert(metadata_ptr != NULL);
 
-	/* Get the metadata associated with this image. */
-	while ((metadata_ptr->id != EVLOG_INVALID_ID) &&
-		(metadata_ptr->id != data_id)) {
-		metadata_ptr++;
+#if EVLOG_REUSE_AUTH_HASH
+	if (event_log_get_verified_hash(data_base, data_size, data_id,
+					hash_data)) {
+		log_stats.hashes_reused++;
+		event_log_record_hash(hash_data, data_id, metadata_ptr);
+		return 0;
 	}
-	assert(metadata_ptr->id != EVLOG_INVALID_ID);
+#endif
 
 	/* Measure the payload with algorithm selected by EventLog driver */
 	rc = event_log_measure(data_base, data_size, hash_data);
@@ -294,11 +394,23 @@ int event_log_measure_and_record(uintptr_t data_base, uint32_t data_size,
 		return rc;
 	}
 
-	event_log_record(hash_data, EV_POST_CODE, metadata_ptr);
+	event_log_record_hash(hash_data, data_id, metadata_ptr);
 
 	return 0;
 }
 
+/*
+ * Get the Event Log usage counters
+ *
+ * @param[out] stats		Counters since Event Log initialisation
+ */
+void event_log_get_stats(event_log_stats_t *stats)
+{
+	assert(stats != NULL);
+
+	*stats = log_stats;
+}
+
 /*
  * Get current Event Log buffer size i.e. used space of Event Log buffer
  *
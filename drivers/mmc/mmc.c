@@ -35,6 +35,14 @@ static struct mmc_device_info *mmc_dev_info;
 static unsigned int rca;
 static unsigned int scr[2]__aligned(16) = { 0 };
 
+/* Read submitted by mmc_submit_read_blocks(), and not completed yet */
+static struct {
+	int lba;
+	uintptr_t buf;
+	size_t size;
+	bool busy;
+} mmc_read_req;
+
 static const unsigned char tran_speed_base[16] = {
 	0, 10, 12, 13, 15, 20, 26, 30, 35, 40, 45, 52, 55, 60, 70, 80
 };
@@ -589,7 +597,14 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 	return ret;
 }
 
-size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
+/*
+ * Asynchronous read: mmc_submit_read_blocks() sends the read command and
+ * returns while the data is transferred, mmc_poll_read_blocks() returns
+ * -EAGAIN until the transfer is over, then completes the read. With a host
+ * controller that cannot report the end of the transfer without waiting
+ * (no read_done() operation), mmc_poll_read_blocks() waits for it.
+ */
+int mmc_submit_read_blocks(int lba, uintptr_t buf, size_t size)
 {
 	int ret;
 	unsigned int cmd_idx, cmd_arg;
@@ -597,11 +612,12 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 	assert((ops != NULL) &&
 	       (ops->read != NULL) &&
 	       (size != 0U) &&
-	       ((size & MMC_BLOCK_MASK) == 0U));
+	       ((size & MMC_BLOCK_MASK) == 0U) &&
+	       !mmc_read_req.busy);
 
 	ret = ops->prepare(lba, buf, size);
 	if (ret != 0) {
-		return 0;
+		return ret;
 	}
 
 	if (is_cmd23_enabled()) {
@@ -609,7 +625,7 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 		ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
 				   MMC_RESPONSE_R1, NULL);
 		if (ret != 0) {
-			return 0;
+			return ret;
 		}
 
 		cmd_idx = MMC_CMD(18);
@@ -630,26 +646,43 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 
 	ret = mmc_send_cmd(cmd_idx, cmd_arg, MMC_RESPONSE_R1, NULL);
 	if (ret != 0) {
-		return 0;
+		return ret;
 	}
 
+	mmc_read_req.lba = lba;
+	mmc_read_req.buf = buf;
+	mmc_read_req.size = size;
+	mmc_read_req.busy = true;
+
+	return 0;
+}
+
+static int mmc_complete_read(int lba, uintptr_t buf, size_t size)
+{
+	int ret;
+
 	ret = ops->read(lba, buf, size);
 	if (ret != 0) {
-		return 0;
+		return ret;
 	}
 
-	/* Wait buffer empty */
-	do {
-		ret = mmc_device_state();
-		if (ret < 0) {
-			return 0;
-		}
-	} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_DATA));
+	/*
+	 * Wait buffer empty, unless the host controller reported the end of
+	 * the data transfer.
+	 */
+	if (ops->read_done == NULL) {
+		do {
+			ret = mmc_device_state();
+			if (ret < 0) {
+				return ret;
+			}
+		} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_DATA));
+	}
 
 	if (!is_cmd23_enabled() && (size > MMC_BLOCK_SIZE)) {
 		ret = mmc_send_cmd(MMC_CMD(12), 0, MMC_RESPONSE_R1B, NULL);
 		if (ret != 0) {
-			return 0;
+			return ret;
 		}
 	}
 
@@ -658,6 +691,59 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 	watchdog_sw_rst();
 #endif
 
+	return 0;
+}
+
+int mmc_poll_read_blocks(void)
+{
+	int ret;
+
+	assert(mmc_read_req.busy);
+
+	if (ops->read_done != NULL) {
+		ret = ops->read_done(mmc_read_req.lba, mmc_read_req.buf,
+				     mmc_read_req.size);
+		if (ret == -EAGAIN) {
+			return ret;
+		}
+
+		if (ret != 0) {
+			mmc_read_req.busy = false;
+			return ret;
+		}
+	}
+
+	mmc_read_req.busy = false;
+
+	return mmc_complete_read(mmc_read_req.lba, mmc_read_req.buf,
+				 mmc_read_req.size);
+}
+
+int mmc_wait_read_blocks(void)
+{
+	int ret;
+
+	do {
+		ret = mmc_poll_read_blocks();
+	} while (ret == -EAGAIN);
+
+	return ret;
+}
+
+size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
+{
+	int ret;
+
+	ret = mmc_submit_read_blocks(lba, buf, size);
+	if (ret != 0) {
+		return 0;
+	}
+
+	ret = mmc_wait_read_blocks();
+	if (ret != 0) {
+		return 0;
+	}
+
 	return size;
 }
 
@@ -15,11 +15,49 @@
 
 #include <platform_def.h>
 
+/*
+ * Number of blocks, from the start of the device, whose bad block status is
+ * cached after it is first read. The status of the other blocks is read from
+ * the device on each access.
+ */
+#ifndef PLATFORM_MTD_BBT_MAX_BLOCKS
+#define PLATFORM_MTD_BBT_MAX_BLOCKS	U(4096)
+#endif
+
+/* Number of good blocks of an area whose location is remembered */
+#ifndef PLATFORM_MTD_REMAP_MAX_BLOCKS
+#define PLATFORM_MTD_REMAP_MAX_BLOCKS	U(64)
+#endif
+
+#define BBT_WORDS	DIV_ROUND_UP_2EVAL(PLATFORM_MTD_BBT_MAX_BLOCKS, 32U)
+
 /*
  * Define a single nand_device used by specific NAND frameworks.
  */
 static struct nand_device nand_dev;
 
+/*
+ * Bad block table: a block has been checked if its bit is set in 'checked',
+ * and is bad if its bit is also set in 'bad'. The table is reset when the
+ * device is set up again with another block check function.
+ */
+static struct {
+	int (*block_is_bad)(unsigned int block);
+	uint32_t checked[BBT_WORDS];
+	uint32_t bad[BBT_WORDS];
+} nand_bbt;
+
+/*
+ * Location of the first good blocks of the last area given to nand_seek_bb():
+ * the logical block N of the area, once bad blocks are skipped, is the
+ * physical block 'block[N]'.
+ */
+static struct {
+	unsigned int base;
+	unsigned int count;
+	unsigned int block[PLATFORM_MTD_REMAP_MAX_BLOCKS];
+} nand_remap;
+
 #pragma weak plat_get_scratch_buffer
 void plat_get_scratch_buffer(void **buffer_addr, size_t *buf_size)
 {
@@ -32,6 +70,120 @@ void plat_get_scratch_buffer(void **buffer_addr, size_t *buf_size)
 	*buf_size = sizeof(scratch_buff);
 }
 
+static void nand_bbt_check_device(void)
+{
+	if (nand_bbt.block_is_bad != nand_dev.mtd_block_is_bad) {
+		zeromem(&nand_bbt, sizeof(nand_bbt));
+		nand_bbt.block_is_bad = nand_dev.mtd_block_is_bad;
+		nand_remap.count = 0U;
+	}
+}
+
+/* Check whether a block is bad, reading its status only the first time */
+static int nand_block_is_bad(unsigned int block)
+{
+	unsigned int word = block / 32U;
+	uint32_t mask = BIT_32(block % 32U);
+	int is_bad;
+
+	if (block >= PLATFORM_MTD_BBT_MAX_BLOCKS) {
+		return nand_dev.mtd_block_is_bad(block);
+	}
+
+	if ((nand_bbt.checked[word] & mask) != 0U) {
+		return ((nand_bbt.bad[word] & mask) != 0U) ? 1 : 0;
+	}
+
+	is_bad = nand_dev.mtd_block_is_bad(block);
+	if (is_bad < 0) {
+		return is_bad;
+	}
+
+	nand_bbt.checked[word] |= mask;
+	if (is_bad == 1) {
+		nand_bbt.bad[word] |= mask;
+	}
+
+	return is_bad;
+}
+
+/*
+ * Find the physical block of the logical block 'logical' of the area starting
+ * at block 'base', bad blocks being skipped.
+ */
+static int nand_remap_block(unsigned int base, unsigned int logical,
+			    unsigned int *block)
+{
+	unsigned int max_block = nand_dev.size / nand_dev.block_size;
+	unsigned int cur, count;
+	int is_bad;
+
+	if (nand_remap.base != base) {
+		nand_remap.base = base;
+		nand_remap.count = 0U;
+	}
+
+	if (logical < nand_remap.count) {
+		*block = nand_remap.block[logical];
+		return 0;
+	}
+
+	/* Carry on from the last known good block of the area */
+	count = nand_remap.count;
+	cur = (count != 0U) ? nand_remap.block[count - 1U] + 1U : base;
+
+	for (; cur < max_block; cur++) {
+		is_bad = nand_block_is_bad(cur);
+		if (is_bad < 0) {
+			return is_bad;
+		}
+
+		if (is_bad == 1) {
+			continue;
+		}
+
+		if (count < PLATFORM_MTD_REMAP_MAX_BLOCKS) {
+			nand_remap.block[count] = cur;
+			nand_remap.count = count + 1U;
+		}
+
+		if (count == logical) {
+			*block = cur;
+			return 0;
+		}
+
+		count++;
+	}
+
+	return -EIO;
+}
+
+/*
+ * Read whole consecutive pages of a block into the buffer, with a single
+ * multi-page transfer when the device supports it.
+ */
+static int nand_read_pages(unsigned int page, unsigned int count,
+			   uintptr_t buffer)
+{
+	unsigned int i;
+	int ret;
+
+	if ((count > 1U) && (nand_dev.mtd_read_pages != NULL)) {
+		return nand_dev.mtd_read_pages(&nand_dev, page, count, buffer);
+	}
+
+	for (i = 0U; i < count; i++) {
+		ret = nand_dev.mtd_read_page(&nand_dev, page + i, buffer);
+		if (ret != 0) {
+			return ret;
+		}
+
+		buffer += nand_dev.page_size;
+	}
+
+	return 0;
+}
+
 int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 	      size_t *length_read)
 {
@@ -57,13 +209,15 @@ int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 
 	*length_read = 0UL;
 
+	nand_bbt_check_device();
+
 	if (((start_offset != 0U) || (length % nand_dev.page_size) != 0U) &&
 	    (scratch_buff_size < nand_dev.page_size)) {
 		return -EINVAL;
 	}
 
 	while (block <= end_block) {
-		is_bad = nand_dev.mtd_block_is_bad(block);
+		is_bad = nand_block_is_bad(block);
 		if (is_bad < 0) {
 			return is_bad;
 		}
@@ -103,14 +257,18 @@ int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 
 				start_offset = 0U;
 			} else {
-				ret = nand_dev.mtd_read_page(&nand_dev,
-						(block * nb_pages) + page,
-						buffer);
+				unsigned int count = (unsigned int)MIN(
+					(size_t)(nb_pages - page),
+					length / nand_dev.page_size);
+
+				ret = nand_read_pages((block * nb_pages) + page,
+						      count, buffer);
 				if (ret != 0) {
 					return ret;
 				}
 
-				bytes_read = nand_dev.page_size;
+				bytes_read = count * nand_dev.page_size;
+				page += count - 1U;
 			}
 
 			length -= bytes_read;
@@ -132,40 +290,28 @@ int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 int nand_seek_bb(uintptr_t base, unsigned int offset, size_t *extra_offset)
 {
 	unsigned int block;
+	unsigned int logical;
 	unsigned int offset_block;
-	unsigned int max_block;
-	int is_bad;
-	size_t count_bb = 0U;
+	int ret;
 
 	block = base / nand_dev.block_size;
 
 	if (offset != 0U) {
-		offset_block = (base + offset - 1U) / nand_dev.block_size;
+		logical = ((base + offset - 1U) / nand_dev.block_size) - block;
 	} else {
-		offset_block = block;
+		logical = 0U;
 	}
 
-	max_block = nand_dev.size / nand_dev.block_size;
-
-	while (block <= offset_block) {
-		if (offset_block >= max_block) {
-			return -EIO;
-		}
-
-		is_bad = nand_dev.mtd_block_is_bad(block);
-		if (is_bad < 0) {
-			return is_bad;
-		}
+	nand_bbt_check_device();
 
-		if (is_bad == 1) {
-			count_bb++;
-			offset_block++;
-		}
-
-		block++;
+	ret = nand_remap_block(block, logical, &offset_block);
+	if (ret != 0) {
+		return ret;
 	}
 
-	*extra_offset = count_bb * nand_dev.block_size;
+	/* Blocks between the logical and the physical one are all bad */
+	*extra_offset = (size_t)(offset_block - block - logical) *
+			nand_dev.block_size;
 
 	return 0;
 }
@@ -323,6 +323,10 @@ static int nand_read_param_page(void)
 	rawnand_dev.nand_dev->block_size = page.num_pages_per_blk *
 					   page.bytes_per_page;
 	rawnand_dev.nand_dev->page_size = page.bytes_per_page;
+
+	if ((page.opt_cmd & ONFI_OPT_CMD_READ_CACHE) != 0U) {
+		rawnand_dev.flags |= RAW_NAND_HAS_READ_CACHE;
+	}
 	rawnand_dev.nand_dev->size = page.num_pages_per_blk *
 				     page.bytes_per_page *
 				     page.num_blk_in_lun * page.num_lun;
@@ -394,6 +398,52 @@ static int nand_mtd_read_page_raw(struct nand_device *nand, unsigned int page,
 				  rawnand_dev.nand_dev->page_size);
 }
 
+static int nand_read_cache_cmd(uint8_t cmd, uintptr_t buffer)
+{
+	int ret;
+
+	ret = nand_send_cmd(cmd, NAND_TWB_MAX);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = nand_send_wait(PSEC_TO_MSEC(NAND_TR_MAX), NAND_TRR_MIN);
+	if (ret != 0) {
+		return ret;
+	}
+
+	return nand_read_data((uint8_t *)buffer,
+			      rawnand_dev.nand_dev->page_size, false);
+}
+
+/*
+ * Sequential cache read: while a page is output from the cache register, the
+ * next one is loaded from the array into the data register.
+ */
+static int nand_mtd_read_pages_raw(struct nand_device *nand, unsigned int page,
+				   unsigned int nb_pages, uintptr_t buffer)
+{
+	unsigned int i;
+	int ret;
+
+	/* Load the first page in the data register */
+	ret = nand_read_page_cmd(page, 0U, 0U, 0U);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (i = 1U; i < nb_pages; i++) {
+		ret = nand_read_cache_cmd(NAND_CMD_READ_CACHE_SEQ, buffer);
+		if (ret != 0) {
+			return ret;
+		}
+
+		buffer += rawnand_dev.nand_dev->page_size;
+	}
+
+	return nand_read_cache_cmd(NAND_CMD_READ_CACHE_END, buffer);
+}
+
 void nand_raw_ctrl_init(const struct nand_ctrl_ops *ops)
 {
 	rawnand_dev.ops = ops;
@@ -410,6 +460,7 @@ int nand_raw_init(unsigned long long *size, unsigned int *erase_size)
 
 	rawnand_dev.nand_dev->mtd_block_is_bad = nand_mtd_block_is_bad;
 	rawnand_dev.nand_dev->mtd_read_page = nand_mtd_read_page_raw;
+	rawnand_dev.nand_dev->mtd_read_pages = NULL;
 	rawnand_dev.nand_dev->ecc.mode = NAND_ECC_NONE;
 
 	if ((rawnand_dev.ops->setup == NULL) ||
@@ -441,5 +492,14 @@ int nand_raw_init(unsigned long long *size, unsigned int *erase_size)
 
 	rawnand_dev.ops->setup(rawnand_dev.nand_dev);
 
+	/*
+	 * Cache reads bypass the controller page read, only use them if the
+	 * controller did not replace it (e.g. for hardware ECC).
+	 */
+	if (((rawnand_dev.flags & RAW_NAND_HAS_READ_CACHE) != 0U) &&
+	    (rawnand_dev.nand_dev->mtd_read_page == nand_mtd_read_page_raw)) {
+		rawnand_dev.nand_dev->mtd_read_pages = nand_mtd_read_pages_raw;
+	}
+
 	return 0;
 }
@@ -123,14 +123,13 @@ static int spi_nand_wait_ready(uint8_t *status)
 	return -ETIMEDOUT;
 }
 
-static int spi_nand_reset(void)
+static int spi_nand_send_cmd(uint8_t opcode, uint8_t *status)
 {
 	struct spi_mem_op op;
-	uint8_t status;
 	int ret;
 
 	zeromem(&op, sizeof(struct spi_mem_op));
-	op.cmd.opcode = SPI_NAND_OP_RESET;
+	op.cmd.opcode = opcode;
 	op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
 
 	ret = spi_mem_exec_op(&op);
@@ -138,7 +137,14 @@ static int spi_nand_reset(void)
 		return ret;
 	}
 
-	return spi_nand_wait_ready(&status);
+	return spi_nand_wait_ready(status);
+}
+
+static int spi_nand_reset(void)
+{
+	uint8_t status;
+
+	return spi_nand_send_cmd(SPI_NAND_OP_RESET, &status);
 }
 
 static int spi_nand_read_id(uint8_t *id)
@@ -192,7 +198,7 @@ static int spi_nand_read_from_cache(unsigned int page, unsigned int offset,
 	spinand_dev.spi_read_cache_op.data.buf = buffer;
 	spinand_dev.spi_read_cache_op.data.nbytes = len;
 
-	return spi_mem_exec_op(&spinand_dev.spi_read_cache_op);
+	return spi_mem_dirmap_read(&spinand_dev.spi_read_cache_op);
 }
 
 static int spi_nand_read_page(unsigned int page, unsigned int offset,
@@ -259,6 +265,64 @@ static int spi_nand_mtd_read_page(struct nand_device *nand, unsigned int page,
 				  spinand_dev.nand_dev->page_size, true);
 }
 
+/*
+ * Sequential cache read: while a page is read from the cache, the next one is
+ * loaded from the array. The ECC status applies to the page in the cache.
+ */
+static int spi_nand_mtd_read_pages(struct nand_device *nand, unsigned int page,
+				   unsigned int nb_pages, uintptr_t buffer)
+{
+	uint8_t *buf = (uint8_t *)buffer;
+	bool ecc_error = false;
+	uint8_t status;
+	uint8_t opcode;
+	unsigned int i;
+	int ret;
+
+	ret = spi_nand_ecc_enable(true);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_nand_load_page(page);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_nand_wait_ready(&status);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (i = 0U; i < nb_pages; i++) {
+		if (i == (nb_pages - 1U)) {
+			opcode = SPI_NAND_OP_READ_CACHE_END;
+		} else {
+			opcode = SPI_NAND_OP_READ_CACHE_SEQ;
+		}
+
+		ret = spi_nand_send_cmd(opcode, &status);
+		if (ret != 0) {
+			return ret;
+		}
+
+		ret = spi_nand_read_from_cache(page + i, 0U, buf,
+					       spinand_dev.nand_dev->page_size);
+		if (ret != 0) {
+			return ret;
+		}
+
+		/* Carry on to leave the cache read mode with the last page */
+		if ((status & SPI_NAND_STATUS_ECC_UNCOR) != 0U) {
+			ecc_error = true;
+		}
+
+		buf += spinand_dev.nand_dev->page_size;
+	}
+
+	return ecc_error ? -EBADMSG : 0;
+}
+
 int spi_nand_init(unsigned long long *size, unsigned int *erase_size)
 {
 	uint8_t id[SPI_NAND_MAX_ID_LEN];
@@ -271,6 +335,7 @@ int spi_nand_init(unsigned long long *size, unsigned int *erase_size)
 
 	spinand_dev.nand_dev->mtd_block_is_bad = spi_nand_mtd_block_is_bad;
 	spinand_dev.nand_dev->mtd_read_page = spi_nand_mtd_read_page;
+	spinand_dev.nand_dev->mtd_read_pages = NULL;
 	spinand_dev.nand_dev->nb_planes = 1;
 
 	spinand_dev.spi_read_cache_op.cmd.opcode = SPI_NAND_OP_READ_FROM_CACHE;
@@ -289,6 +354,10 @@ int spi_nand_init(unsigned long long *size, unsigned int *erase_size)
 	       (spinand_dev.nand_dev->block_size != 0U) &&
 	       (spinand_dev.nand_dev->size != 0U));
 
+	if ((spinand_dev.flags & SPI_NAND_HAS_READ_CACHE) != 0U) {
+		spinand_dev.nand_dev->mtd_read_pages = spi_nand_mtd_read_pages;
+	}
+
 	ret = spi_nand_reset();
 	if (ret != 0) {
 		return ret;
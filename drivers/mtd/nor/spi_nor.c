@@ -214,7 +214,7 @@ static int spi_nor_quad_enable(void)
 	return 0;
 }
 
-static int spi_nor_clean_bar(void)
+int spi_nor_clean_bar(void)
 {
 	int ret;
 
@@ -300,7 +300,7 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 			nor_dev.read_op.data.nbytes = length;
 		}
 
-		ret = spi_mem_exec_op(&nor_dev.read_op);
+		ret = spi_mem_dirmap_read(&nor_dev.read_op);
 		if (ret != 0) {
 			spi_nor_clean_bar();
 			return ret;
@@ -312,11 +312,62 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 		*length_read += nor_dev.read_op.data.nbytes;
 	}
 
+	/*
+	 * The bank register is kept across reads, consecutive reads of the
+	 * same image do not rewrite it. It is reset with spi_nor_clean_bar()
+	 * before the next boot stage is entered.
+	 */
+	return 0;
+}
+
+int spi_nor_map(unsigned int offset, size_t length, uintptr_t *address)
+{
+	struct spi_mem_op op = nor_dev.read_op;
+
+	/* The window only covers the selected bank */
 	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
-		ret = spi_nor_clean_bar();
-		if (ret != 0) {
-			return ret;
-		}
+		return -ENOTSUP;
+	}
+
+	op.addr.val = offset;
+	op.data.buf = NULL;
+	op.data.nbytes = length;
+
+	return spi_mem_dirmap_map(&op, address);
+}
+
+static int spi_nor_set_4b_read_op(void)
+{
+	switch (nor_dev.read_op.cmd.opcode) {
+	case SPI_NOR_OP_READ:
+		nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ_4B;
+		break;
+	case SPI_NOR_OP_READ_FAST:
+		nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ_FAST_4B;
+		break;
+	case SPI_NOR_OP_READ_1_1_2:
+		nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ_1_1_2_4B;
+		break;
+	case SPI_NOR_OP_READ_1_2_2:
+		nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ_1_2_2_4B;
+		break;
+	case SPI_NOR_OP_READ_1_1_4:
+		nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ_1_1_4_4B;
+		break;
+	case SPI_NOR_OP_READ_1_4_4:
+		nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ_1_4_4_4B;
+		break;
+	case SPI_NOR_OP_READ_4B:
+	case SPI_NOR_OP_READ_FAST_4B:
+	case SPI_NOR_OP_READ_1_1_2_4B:
+	case SPI_NOR_OP_READ_1_2_2_4B:
+	case SPI_NOR_OP_READ_1_1_4_4B:
+	case SPI_NOR_OP_READ_1_4_4_4B:
+		break;
+	default:
+		ERROR("%s: no 4-byte address read for opcode %x\n", __func__,
+		      nor_dev.read_op.cmd.opcode);
+		return -EINVAL;
 	}
 
 	return 0;
@@ -341,7 +392,16 @@ int spi_nor_init(unsigned long long *size, unsigned int *erase_size)
 
 	assert(nor_dev.size != 0U);
 
-	if (nor_dev.size > BANK_SIZE) {
+	/*
+	 * With 4-byte addresses, the whole device is reachable without bank,
+	 * provided the read uses an opcode that takes a 4-byte address.
+	 */
+	if (nor_dev.read_op.addr.nbytes == 4U) {
+		ret = spi_nor_set_4b_read_op();
+		if (ret != 0) {
+			return ret;
+		}
+	} else if (nor_dev.size > BANK_SIZE) {
 		nor_dev.flags |= SPI_NOR_USE_BANK;
 	}
 
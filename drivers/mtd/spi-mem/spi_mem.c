@@ -174,6 +174,85 @@ int spi_mem_exec_op(const struct spi_mem_op *op)
 	return ret;
 }
 
+/*
+ * spi_mem_dirmap_read() - Execute a memory read operation through the
+ * memory-mapped window of the controller.
+ * @op: The memory read operation to execute.
+ *
+ * The operation is executed as a regular command transaction if the
+ * controller has no memory-mapped window, or if it cannot map @op.
+ *
+ * Return: 0 in case of success, a negative error code otherwise.
+ */
+int spi_mem_dirmap_read(const struct spi_mem_op *op)
+{
+	const struct spi_bus_ops *ops = spi_slave.ops;
+	int ret;
+
+	assert(op->data.dir == SPI_MEM_DATA_IN);
+
+	if (ops->dirmap_read == NULL) {
+		return spi_mem_exec_op(op);
+	}
+
+	if (!spi_mem_supports_op(op)) {
+		WARN("Error in spi_mem_support\n");
+		return -ENOTSUP;
+	}
+
+	ret = ops->claim_bus(spi_slave.cs);
+	if (ret != 0) {
+		WARN("Error claim_bus\n");
+		return ret;
+	}
+
+	ret = ops->dirmap_read(op);
+
+	ops->release_bus();
+
+	if (ret == -ENOTSUP) {
+		return spi_mem_exec_op(op);
+	}
+
+	return ret;
+}
+
+/*
+ * spi_mem_dirmap_map() - Map the data of a memory read operation.
+ * @op: The memory read operation, addr.val and data.nbytes give the area.
+ * @address: [out] Address at which the data at @op->addr.val can be read.
+ *
+ * The bus is left claimed with the memory-mapped window of the controller
+ * enabled. The mapping is only valid until the next operation on the bus.
+ *
+ * Return: 0 in case of success, -ENOTSUP if the controller cannot map @op,
+ * another negative error code otherwise.
+ */
+int spi_mem_dirmap_map(const struct spi_mem_op *op, uintptr_t *address)
+{
+	const struct spi_bus_ops *ops = spi_slave.ops;
+	int ret;
+
+	assert((op->data.dir == SPI_MEM_DATA_IN) && (address != NULL));
+
+	if ((ops->dirmap_map == NULL) || !spi_mem_supports_op(op)) {
+		return -ENOTSUP;
+	}
+
+	ret = ops->claim_bus(spi_slave.cs);
+	if (ret != 0) {
+		WARN("Error claim_bus\n");
+		return ret;
+	}
+
+	ret = ops->dirmap_map(op, address);
+	if (ret != 0) {
+		ops->release_bus();
+	}
+
+	return ret;
+}
+
 /*
  * spi_mem_init_slave() - SPI slave device initialization.
  * @fdt: Pointer to the device tree blob.
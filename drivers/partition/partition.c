@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -18,9 +19,48 @@
 #include <drivers/partition/mbr.h>
 #include <plat/common/platform.h>
 
+/* Number of GPT entries read from the device at once */
+#define GPT_ENTRIES_PER_READ						\
+	(((LBA(PLAT_PARTITION_READ_BLOCKS) / sizeof(gpt_entry_t)) <	\
+	  PLAT_PARTITION_MAX_ENTRIES) ?					\
+	 (LBA(PLAT_PARTITION_READ_BLOCKS) / sizeof(gpt_entry_t)) :	\
+	 PLAT_PARTITION_MAX_ENTRIES)
+
+/*
+ * Entries of 'list' sorted by one of their keys, for lookups by binary search.
+ * Entries with equal keys stay in table order, so that lookups return the
+ * first matching entry of the table.
+ */
+typedef struct partition_index {
+	uint8_t		entry[PLAT_PARTITION_MAX_ENTRIES];
+	size_t		key_offset;
+	int		(*cmp)(const void *key1, const void *key2);
+} partition_index_t;
+
+static int name_cmp(const void *key1, const void *key2)
+{
+	return strcmp(key1, key2);
+}
+
 static uint8_t mbr_sector[PLAT_PARTITION_BLOCK_SIZE];
+static gpt_entry_t gpt_entries[GPT_ENTRIES_PER_READ];
 static partition_entry_list_t list;
 
+static partition_index_t name_index = {
+	.key_offset = offsetof(partition_entry_t, name),
+	.cmp = name_cmp,
+};
+
+static partition_index_t type_index = {
+	.key_offset = offsetof(partition_entry_t, type_guid),
+	.cmp = guidcmp,
+};
+
+static partition_index_t uuid_index = {
+	.key_offset = offsetof(partition_entry_t, part_guid),
+	.cmp = guidcmp,
+};
+
 #if LOG_LEVEL >= LOG_LEVEL_VERBOSE
 static void dump_entries(int num)
 {
@@ -209,20 +249,21 @@ static int load_mbr_entries(uintptr_t image_handle)
 }
 
 /*
- * Try to read and load a single GPT entry.
+ * Try to read and load a number of consecutive GPT entries.
  */
-static int load_gpt_entry(uintptr_t image_handle, gpt_entry_t *entry)
+static int load_gpt_entries(uintptr_t image_handle, gpt_entry_t *entries,
+			    int num)
 {
 	size_t bytes_read = 0U;
+	size_t length = (size_t)num * sizeof(gpt_entry_t);
 	int result;
 
-	assert(entry != NULL);
-	result = io_read(image_handle, (uintptr_t)entry, sizeof(gpt_entry_t),
-			&bytes_read);
-	if ((result != 0) || (sizeof(gpt_entry_t) != bytes_read)) {
+	assert(entries != NULL);
+	result = io_read(image_handle, (uintptr_t)entries, length, &bytes_read);
+	if ((result != 0) || (length != bytes_read)) {
 		VERBOSE("GPT Entry read error(%i) or read mismatch occurred,"
 			"expected(%zu) and actual(%zu)\n", result,
-			sizeof(gpt_entry_t), bytes_read);
+			length, bytes_read);
 		return -EINVAL;
 	}
 
@@ -230,15 +271,15 @@ static int load_gpt_entry(uintptr_t image_handle, gpt_entry_t *entry)
 }
 
 /*
- * Retrieve each entry in the partition table, parse the data from each
- * entry and store them in the list of partition table entries.
+ * Retrieve the entries of the partition table, GPT_ENTRIES_PER_READ at a
+ * time, parse the data from each entry and store them in the list of
+ * partition table entries.
  */
 static int load_partition_gpt(uintptr_t image_handle,
 			      unsigned long long part_lba)
 {
 	const signed long long gpt_entry_offset = LBA(part_lba);
-	gpt_entry_t entry;
-	int result, i;
+	int result, i, num = 0;
 
 	result = io_seek(image_handle, IO_SEEK_SET, gpt_entry_offset);
 	if (result != 0) {
@@ -248,14 +289,23 @@ static int load_partition_gpt(uintptr_t image_handle,
 	}
 
 	for (i = 0; i < list.entry_count; i++) {
-		result = load_gpt_entry(image_handle, &entry);
-		if (result != 0) {
-			VERBOSE("Failed to load gpt entry data(%i) error is (%i)\n",
-				i, result);
-			return result;
+		if ((i % GPT_ENTRIES_PER_READ) == 0) {
+			num = list.entry_count - i;
+			if (num > GPT_ENTRIES_PER_READ) {
+				num = GPT_ENTRIES_PER_READ;
+			}
+
+			result = load_gpt_entries(image_handle, gpt_entries,
+						  num);
+			if (result != 0) {
+				VERBOSE("Failed to load gpt entry data(%i) error is (%i)\n",
+					i, result);
+				return result;
+			}
 		}
 
-		result = parse_gpt_entry(&entry, &list.list[i]);
+		result = parse_gpt_entry(&gpt_entries[i % GPT_ENTRIES_PER_READ],
+					 &list.list[i]);
 		if (result != 0) {
 			break;
 		}
@@ -359,10 +409,64 @@ static int load_primary_gpt(uintptr_t image_handle, unsigned int first_lba)
 	return load_partition_gpt(image_handle, part_lba);
 }
 
+static const void *index_key(const partition_index_t *index, int i)
+{
+	return (const uint8_t *)&list.list[index->entry[i]] + index->key_offset;
+}
+
 /*
- * Load the partition table info based on the image id provided.
+ * Sort the entries of the list by the key of the index. The tables are small
+ * enough for an insertion sort, which keeps entries with equal keys in table
+ * order.
  */
-int load_partition_table(unsigned int image_id)
+static void build_partition_index(partition_index_t *index)
+{
+	int i, j;
+	uint8_t entry;
+
+	for (i = 0; i < list.entry_count; i++) {
+		index->entry[i] = (uint8_t)i;
+		for (j = i; j > 0; j--) {
+			if (index->cmp(index_key(index, j - 1),
+				       index_key(index, j)) <= 0) {
+				break;
+			}
+			entry = index->entry[j];
+			index->entry[j] = index->entry[j - 1];
+			index->entry[j - 1] = entry;
+		}
+	}
+}
+
+/*
+ * Binary search for the first entry of the index whose key is equal to 'key'.
+ */
+static const partition_entry_t *find_partition_entry(
+	const partition_index_t *index, const void *key)
+{
+	int low = 0, high = list.entry_count, mid;
+
+	while (low < high) {
+		mid = low + ((high - low) / 2);
+		if (index->cmp(key, index_key(index, mid)) > 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if ((low < list.entry_count) &&
+	    (index->cmp(key, index_key(index, low)) == 0)) {
+		return &list.list[index->entry[low]];
+	}
+
+	return NULL;
+}
+
+/*
+ * Load the list of partition table entries from the image id provided.
+ */
+static int load_partition_entries(unsigned int image_id)
 {
 	uintptr_t dev_handle, image_handle, image_spec = 0;
 	mbr_entry_t mbr_entry;
@@ -402,19 +506,29 @@ out:
 	return result;
 }
 
+/*
+ * Load the partition table info based on the image id provided, and index
+ * the entries by name, type GUID and partition GUID.
+ */
+int load_partition_table(unsigned int image_id)
+{
+	int result;
+
+	result = load_partition_entries(image_id);
+
+	build_partition_index(&name_index);
+	build_partition_index(&type_index);
+	build_partition_index(&uuid_index);
+
+	return result;
+}
+
 /*
  * Try retrieving a partition table entry based on the name of the partition.
  */
 const partition_entry_t *get_partition_entry(const char *name)
 {
-	int i;
-
-	for (i = 0; i < list.entry_count; i++) {
-		if (strcmp(name, list.list[i].name) == 0) {
-			return &list.list[i];
-		}
-	}
-	return NULL;
+	return find_partition_entry(&name_index, name);
 }
 
 /*
@@ -422,15 +536,7 @@ const partition_entry_t *get_partition_entry(const char *name)
  */
 const partition_entry_t *get_partition_entry_by_type(const uuid_t *type_uuid)
 {
-	int i;
-
-	for (i = 0; i < list.entry_count; i++) {
-		if (guidcmp(type_uuid, &list.list[i].type_guid) == 0) {
-			return &list.list[i];
-		}
-	}
-
-	return NULL;
+	return find_partition_entry(&type_index, type_uuid);
 }
 
 /*
@@ -438,15 +544,7 @@ const partition_entry_t *get_partition_entry_by_type(const uuid_t *type_uuid)
  */
 const partition_entry_t *get_partition_entry_by_uuid(const uuid_t *part_uuid)
 {
-	int i;
-
-	for (i = 0; i < list.entry_count; i++) {
-		if (guidcmp(part_uuid, &list.list[i].part_guid) == 0) {
-			return &list.list[i];
-		}
-	}
-
-	return NULL;
+	return find_partition_entry(&uuid_index, part_uuid);
 }
 
 /*
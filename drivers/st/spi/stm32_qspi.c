@@ -111,6 +111,7 @@ struct stm32_qspi_ctrl {
 	size_t mm_size;
 	unsigned long clock_id;
 	unsigned int reset_id;
+	bool mm_active;
 };
 
 static struct stm32_qspi_ctrl stm32_qspi;
@@ -207,15 +208,62 @@ static int stm32_qspi_poll(const struct spi_mem_op *op)
 	return 0;
 }
 
+/*
+ * Copy from the memory-mapped window with 64-bit loads when the source and
+ * the destination can be aligned together, so that the controller fetches
+ * whole words instead of single bytes.
+ */
 static int stm32_qspi_mm(const struct spi_mem_op *op)
 {
-	memcpy(op->data.buf,
-	       (void *)(stm32_qspi.mm_base + (size_t)op->addr.val),
-	       op->data.nbytes);
+	uintptr_t src = stm32_qspi.mm_base + (size_t)op->addr.val;
+	uint8_t *dst = op->data.buf;
+	size_t len = op->data.nbytes;
+
+	if ((((uintptr_t)dst ^ src) & (sizeof(uint64_t) - 1U)) == 0U) {
+		while ((len != 0U) && ((src & (sizeof(uint64_t) - 1U)) != 0U)) {
+			*dst++ = mmio_read_8(src++);
+			len--;
+		}
+
+		while (len >= sizeof(uint64_t)) {
+			*(uint64_t *)dst = mmio_read_64(src);
+			dst += sizeof(uint64_t);
+			src += sizeof(uint64_t);
+			len -= sizeof(uint64_t);
+		}
+	}
+
+	while (len != 0U) {
+		*dst++ = mmio_read_8(src++);
+		len--;
+	}
 
 	return 0;
 }
 
+static int stm32_qspi_abort(void)
+{
+	uint64_t timeout;
+	int ret = 0;
+
+	mmio_setbits_32(qspi_base() + QSPI_CR, QSPI_CR_ABORT);
+
+	/* Wait clear of abort bit by hardware */
+	timeout = timeout_init_us(QSPI_ABT_TIMEOUT_US);
+	while ((mmio_read_32(qspi_base() + QSPI_CR) & QSPI_CR_ABORT) != 0U) {
+		if (timeout_elapsed(timeout)) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+	}
+
+	mmio_write_32(qspi_base() + QSPI_FCR, QSPI_FCR_CTCF);
+
+	stm32_qspi.mm_active = false;
+
+	return ret;
+}
+
 static int stm32_qspi_tx(const struct spi_mem_op *op, uint8_t mode)
 {
 	if (op->data.nbytes == 0U) {
@@ -238,29 +286,17 @@ static unsigned int stm32_qspi_get_mode(uint8_t buswidth)
 	return buswidth;
 }
 
-static int stm32_qspi_exec_op(const struct spi_mem_op *op)
+static bool stm32_qspi_mm_supports_op(const struct spi_mem_op *op)
 {
-	uint64_t timeout;
-	uint32_t ccr;
-	size_t addr_max;
-	uint8_t mode = QSPI_CCR_IND_WRITE;
-	int ret;
-
-	VERBOSE("%s: cmd:%x mode:%d.%d.%d.%d addr:%" PRIx64 " len:%x\n",
-		__func__, op->cmd.opcode, op->cmd.buswidth, op->addr.buswidth,
-		op->dummy.buswidth, op->data.buswidth,
-		op->addr.val, op->data.nbytes);
+	size_t addr_max = op->addr.val + op->data.nbytes + 1U;
 
-	addr_max = op->addr.val + op->data.nbytes + 1U;
+	return (op->data.nbytes != 0U) && (op->addr.buswidth != 0U) &&
+	       (addr_max < stm32_qspi.mm_size);
+}
 
-	if ((op->data.dir == SPI_MEM_DATA_IN) && (op->data.nbytes != 0U)) {
-		if ((addr_max < stm32_qspi.mm_size) &&
-		    (op->addr.buswidth != 0U)) {
-			mode = QSPI_CCR_MEM_MAP;
-		} else {
-			mode = QSPI_CCR_IND_READ;
-		}
-	}
+static void stm32_qspi_set_ccr(const struct spi_mem_op *op, uint8_t mode)
+{
+	uint32_t ccr;
 
 	if (op->data.nbytes != 0U) {
 		mmio_write_32(qspi_base() + QSPI_DLR, op->data.nbytes - 1U);
@@ -291,6 +327,27 @@ static int stm32_qspi_exec_op(const struct spi_mem_op *op)
 	if ((op->addr.nbytes != 0U) && (mode != QSPI_CCR_MEM_MAP)) {
 		mmio_write_32(qspi_base() + QSPI_AR, op->addr.val);
 	}
+}
+
+static int stm32_qspi_exec(const struct spi_mem_op *op, uint8_t mode)
+{
+	int ret;
+
+	VERBOSE("%s: cmd:%x mode:%d.%d.%d.%d addr:%" PRIx64 " len:%x\n",
+		__func__, op->cmd.opcode, op->cmd.buswidth, op->addr.buswidth,
+		op->dummy.buswidth, op->data.buswidth,
+		op->addr.val, op->data.nbytes);
+
+	/* Leave a memory-mapped window set up by stm32_qspi_dirmap_map() */
+	if (stm32_qspi.mm_active) {
+		ret = stm32_qspi_abort();
+		if (ret != 0) {
+			ERROR("%s: exec op error\n", __func__);
+			return ret;
+		}
+	}
+
+	stm32_qspi_set_ccr(op, mode);
 
 	ret = stm32_qspi_tx(op, mode);
 
@@ -314,19 +371,10 @@ static int stm32_qspi_exec_op(const struct spi_mem_op *op)
 	return 0;
 
 abort:
-	mmio_setbits_32(qspi_base() + QSPI_CR, QSPI_CR_ABORT);
-
-	/* Wait clear of abort bit by hardware */
-	timeout = timeout_init_us(QSPI_ABT_TIMEOUT_US);
-	while ((mmio_read_32(qspi_base() + QSPI_CR) & QSPI_CR_ABORT) != 0U) {
-		if (timeout_elapsed(timeout)) {
-			ret = -ETIMEDOUT;
-			break;
-		}
+	if (stm32_qspi_abort() != 0) {
+		ret = -ETIMEDOUT;
 	}
 
-	mmio_write_32(qspi_base() + QSPI_FCR, QSPI_FCR_CTCF);
-
 	if (ret != 0) {
 		ERROR("%s: exec op error\n", __func__);
 	}
@@ -334,6 +382,54 @@ abort:
 	return ret;
 }
 
+static int stm32_qspi_exec_op(const struct spi_mem_op *op)
+{
+	uint8_t mode = QSPI_CCR_IND_WRITE;
+
+	if ((op->data.dir == SPI_MEM_DATA_IN) && (op->data.nbytes != 0U)) {
+		mode = QSPI_CCR_IND_READ;
+	}
+
+	return stm32_qspi_exec(op, mode);
+}
+
+static int stm32_qspi_dirmap_read(const struct spi_mem_op *op)
+{
+	if (!stm32_qspi_mm_supports_op(op)) {
+		return -ENOTSUP;
+	}
+
+	return stm32_qspi_exec(op, QSPI_CCR_MEM_MAP);
+}
+
+static int stm32_qspi_dirmap_map(const struct spi_mem_op *op,
+				 uintptr_t *address)
+{
+	int ret;
+
+	if (!stm32_qspi_mm_supports_op(op)) {
+		return -ENOTSUP;
+	}
+
+	if (stm32_qspi.mm_active) {
+		ret = stm32_qspi_abort();
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	/*
+	 * Prefetching is not stopped here, the window stays enabled until the
+	 * next operation on the bus aborts it.
+	 */
+	stm32_qspi_set_ccr(op, QSPI_CCR_MEM_MAP);
+	stm32_qspi.mm_active = true;
+
+	*address = stm32_qspi.mm_base + (size_t)op->addr.val;
+
+	return 0;
+}
+
 static int stm32_qspi_claim_bus(unsigned int cs)
 {
 	uint32_t cr;
@@ -442,6 +538,8 @@ static const struct spi_bus_ops stm32_qspi_bus_ops = {
 	.set_speed = stm32_qspi_set_speed,
 	.set_mode = stm32_qspi_set_mode,
 	.exec_op = stm32_qspi_exec_op,
+	.dirmap_read = stm32_qspi_dirmap_read,
+	.dirmap_map = stm32_qspi_dirmap_map,
 };
 
 int stm32_qspi_init(void)
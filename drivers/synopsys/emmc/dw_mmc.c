@@ -126,6 +126,7 @@ static int dw_set_ios(unsigned int clk, unsigned int width);
 static int dw_prepare(int lba, uintptr_t buf, size_t size);
 static int dw_read(int lba, uintptr_t buf, size_t size);
 static int dw_write(int lba, uintptr_t buf, size_t size);
+static int dw_read_done(int lba, uintptr_t buf, size_t size);
 
 static const struct mmc_ops dw_mmc_ops = {
 	.init		= dw_init,
@@ -134,6 +135,7 @@ static const struct mmc_ops dw_mmc_ops = {
 	.prepare	= dw_prepare,
 	.read		= dw_read,
 	.write		= dw_write,
+	.read_done	= dw_read_done,
 };
 
 static dw_mmc_params_t dw_params;
@@ -413,6 +415,23 @@ static int dw_write(int lba, uintptr_t buf, size_t size)
 	return 0;
 }
 
+static int dw_read_done(int lba, uintptr_t buf, size_t size)
+{
+	uint32_t data;
+
+	data = mmio_read_32(dw_params.reg_base + DWMMC_RINTSTS);
+	if ((data & (INT_EBE | INT_SBE | INT_DRT | INT_DCRC)) != 0U) {
+		ERROR("%s, RINTSTS:0x%x\n", __func__, data);
+		return -EIO;
+	}
+
+	if ((data & INT_DTO) == 0U) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
 void dw_mmc_init(dw_mmc_params_t *params, struct mmc_device_info *info)
 {
 	assert((params != 0) &&
@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <drivers/delay_timer.h>
 #include <drivers/ufs.h>
+#include <lib/cassert.h>
 #include <lib/mmio.h>
 
 #define CDB_ADDR_MASK			127
@@ -27,8 +28,38 @@
 
 #define MAX_PRDT_SIZE			0x40000		/* 256KB */
 
+/* Size of the reads queued by ufs_read_blocks(), one PRDT entry each */
+#define UFS_QUEUED_READ_SIZE		MAX_PRDT_SIZE
+
+/*
+ * Requests are only issued on every UTRD_SLOT_STRIDE-th slot, so that no two
+ * requests in flight have their UTRD in the same cache line. Otherwise
+ * cleaning the UTRD of a new request could overwrite the status written by
+ * the controller for another one.
+ */
+#define UTRD_SLOT_STRIDE		((CACHE_WRITEBACK_GRANULE > UTP_TRD_SIZE) ? \
+					 (CACHE_WRITEBACK_GRANULE / UTP_TRD_SIZE) : 1)
+
+/* Command descriptor space following the UTRD, in the single slot layout */
+#define UCD_MIN_SIZE			(UFS_DESC_SIZE - ALIGN_CDB(UTP_TRD_SIZE))
+
+CASSERT((UFS_MAX_QUEUE_DEPTH > 0) && (UFS_MAX_QUEUE_DEPTH <= 32),
+	assert_ufs_max_queue_depth);
+
+/* Read submitted with ufs_submit_read_blocks() */
+typedef struct ufs_request {
+	utp_utrd_t	utrd;
+	uintptr_t	buf;
+	size_t		length;
+} ufs_request_t;
+
 static ufs_params_t ufs_params;
 static int nutrs;	/* Number of UTP Transfer Request Slots */
+static int queue_depth;	/* Number of requests that can be in flight */
+static uintptr_t ucd_base;	/* UTP Command Descriptor of the first request */
+static size_t ucd_size;		/* UTP Command Descriptor size, with the PRDT */
+static ufs_request_t requests[UFS_MAX_QUEUE_DEPTH];
+static unsigned int busy_requests;	/* Submitted and not yet completed */
 
 /*
  * ufs_uic_error_handler - UIC error interrupts handler
@@ -373,35 +404,51 @@ static int ufshc_link_startup(uintptr_t base)
 	return -EIO;
 }
 
-/* Read Door Bell register to check if slot zero is available */
-static int is_slot_available(void)
+/* Read Door Bell register to check if the slot is available */
+static int is_slot_available(int slot)
 {
-	if (mmio_read_32(ufs_params.reg_base + UTRLDBR) & 0x1) {
+	if (mmio_read_32(ufs_params.reg_base + UTRLDBR) & (1U << slot)) {
 		return -EBUSY;
 	}
 	return 0;
 }
 
+/* Find a request that is not in flight, return its index */
+static int get_free_request(void)
+{
+	int i;
+
+	for (i = 0; i < queue_depth; i++) {
+		if (((busy_requests & (1U << i)) == 0U) &&
+		    (is_slot_available(i * UTRD_SLOT_STRIDE) == 0)) {
+			return i;
+		}
+	}
+	return -EBUSY;
+}
+
 static void get_utrd(utp_utrd_t *utrd)
 {
 	uintptr_t base;
-	int result;
+	int result, slot;
 	utrd_header_t *hd;
 
 	assert(utrd != NULL);
-	result = is_slot_available();
-	assert(result == 0);
+	result = get_free_request();
+	assert(result >= 0);
+	slot = result * UTRD_SLOT_STRIDE;
 
 	/* clear utrd */
 	memset((void *)utrd, 0, sizeof(utp_utrd_t));
-	base = ufs_params.desc_base;
+	base = ufs_params.desc_base + (slot * UTP_TRD_SIZE);
 	/* clear the descriptor */
-	memset((void *)base, 0, UFS_DESC_SIZE);
+	memset((void *)base, 0, UTP_TRD_SIZE);
 
 	utrd->header = base;
-	utrd->task_tag = 1; /* We always use the first slot */
+	utrd->task_tag = slot + 1;
 	/* CDB address should be aligned with 128 bytes */
-	utrd->upiu = ALIGN_CDB(utrd->header + sizeof(utrd_header_t));
+	utrd->upiu = ucd_base + (result * ucd_size);
+	memset((void *)utrd->upiu, 0, UCD_MIN_SIZE);
 	utrd->resp_upiu = ALIGN_8(utrd->upiu + sizeof(cmd_upiu_t));
 	utrd->size_upiu = utrd->resp_upiu - utrd->upiu;
 	utrd->size_resp_upiu = ALIGN_8(sizeof(resp_upiu_t));
@@ -494,7 +541,7 @@ static int ufs_prepare_cmd(utp_utrd_t *utrd, uint8_t op, uint8_t lun,
 		assert(lba_cnt <= UINT16_MAX);
 		prdt = (prdt_t *)utrd->prdt;
 
-		desc_limit = ufs_params.desc_base + ufs_params.desc_size;
+		desc_limit = utrd->upiu + ucd_size;
 		while (length > 0) {
 			if ((uintptr_t)prdt + sizeof(prdt_t) > desc_limit) {
 				ERROR("UFS: Exceeded descriptor limit. Image is too large\n");
@@ -519,7 +566,8 @@ static int ufs_prepare_cmd(utp_utrd_t *utrd, uint8_t op, uint8_t lun,
 	}
 
 	prdt_end = utrd->prdt + utrd->prdt_length * sizeof(prdt_t);
-	flush_dcache_range(utrd->header, prdt_end - utrd->header);
+	flush_dcache_range(utrd->header, UTP_TRD_SIZE);
+	flush_dcache_range(utrd->upiu, prdt_end - utrd->upiu);
 	return 0;
 }
 
@@ -572,7 +620,8 @@ static int ufs_prepare_query(utp_utrd_t *utrd, uint8_t op, uint8_t idn,
 		assert(0);
 		break;
 	}
-	flush_dcache_range((uintptr_t)utrd->header, UFS_DESC_SIZE);
+	flush_dcache_range((uintptr_t)utrd->header, UTP_TRD_SIZE);
+	flush_dcache_range((uintptr_t)utrd->upiu, UCD_MIN_SIZE);
 	return 0;
 }
 
@@ -590,7 +639,8 @@ static void ufs_prepare_nop_out(utp_utrd_t *utrd)
 
 	nop_out->trans_type = 0;
 	nop_out->task_tag = utrd->task_tag;
-	flush_dcache_range((uintptr_t)utrd->header, UFS_DESC_SIZE);
+	flush_dcache_range((uintptr_t)utrd->header, UTP_TRD_SIZE);
+	flush_dcache_range((uintptr_t)utrd->upiu, UCD_MIN_SIZE);
 }
 
 static void ufs_send_request(int task_tag)
@@ -612,32 +662,90 @@ static void ufs_send_request(int task_tag)
 	mmio_setbits_32(ufs_params.reg_base + UTRLDBR, 1U << slot);
 }
 
-static int ufs_check_resp(utp_utrd_t *utrd, int trans_type, unsigned int timeout_ms)
+/*
+ * ufs_poll_slot - check whether the request of a slot has completed
+ * @slot: transfer request slot
+ *
+ * Returns
+ * 0 - the request has completed
+ * -EBUSY - the request is still in flight
+ * -EIO - fatal error, needs re-init
+ * -EAGAIN - non-fatal error, caller can retry
+ */
+static int ufs_poll_slot(int slot)
+{
+	uint32_t interrupt_status;
+
+	interrupt_status = mmio_read_32(ufs_params.reg_base + IS) &
+			   mmio_read_32(ufs_params.reg_base + IE);
+	if (interrupt_status & UFS_INT_ERR) {
+		mmio_write_32(ufs_params.reg_base + IS, interrupt_status & UFS_INT_ERR);
+		return ufs_error_handler(interrupt_status, false);
+	}
+
+	/* The controller clears the door bell once the UTRD is updated */
+	if (is_slot_available(slot) != 0) {
+		return -EBUSY;
+	}
+
+	mmio_write_32(ufs_params.reg_base + IS, UFS_INT_UTRCS);
+	return 0;
+}
+
+/*
+ * ufs_wait_for_slot - wait for the request of a slot to complete
+ * @slot: transfer request slot
+ * @timeout_ms: timeout in milliseconds to poll for
+ *
+ * The request is removed from the slot on error and on timeout.
+ *
+ * Returns
+ * 0 - the request has completed
+ * -EIO - fatal error, needs re-init
+ * -EAGAIN - non-fatal error, caller can retry
+ * -ETIMEDOUT - timed out waiting for the request
+ */
+static int ufs_wait_for_slot(int slot, unsigned int timeout_ms)
+{
+	uint64_t timeout = timeout_init_us(timeout_ms * 1000U);
+	int result;
+
+	do {
+		result = ufs_poll_slot(slot);
+		if (result != -EBUSY) {
+			break;
+		}
+	} while (!timeout_elapsed(timeout));
+
+	if (result == -EBUSY) {
+		result = -ETIMEDOUT;
+	}
+
+	if (result != 0) {
+		/* Writing 0 to the bit of the slot clears the request */
+		mmio_write_32(ufs_params.reg_base + UTRLCLR, ~(1U << slot));
+	}
+
+	return result;
+}
+
+/* Check the status and the response of a completed request */
+static int ufs_check_utrd(utp_utrd_t *utrd, int trans_type)
 {
 	utrd_header_t *hd;
 	resp_upiu_t *resp;
 	sense_data_t *sense;
-	unsigned int data;
-	int slot, result;
 
 	hd = (utrd_header_t *)utrd->header;
 	resp = (resp_upiu_t *)utrd->resp_upiu;
 
-	result = ufs_wait_for_int_status(UFS_INT_UTRCS, timeout_ms, false);
-	if (result != 0) {
-		return result;
-	}
-
-	slot = utrd->task_tag - 1;
-
-	data = mmio_read_32(ufs_params.reg_base + UTRLDBR);
-	assert((data & (1 << slot)) == 0);
 	/*
 	 * Invalidate the header after DMA read operation has
 	 * completed to avoid cpu referring to the prefetched
 	 * data brought in before DMA completion.
 	 */
-	inv_dcache_range((uintptr_t)hd, UFS_DESC_SIZE);
+	inv_dcache_range((uintptr_t)hd, UTP_TRD_SIZE);
+	inv_dcache_range(utrd->upiu, UCD_MIN_SIZE);
 	assert(hd->ocs == OCS_SUCCESS);
 	assert((resp->trans_type & TRANS_TYPE_CODE_MASK) == trans_type);
 
@@ -650,11 +758,21 @@ static int ufs_check_resp(utp_utrd_t *utrd, int trans_type, unsigned int timeout
 	}
 
 	(void)resp;
-	(void)slot;
-	(void)data;
 	return 0;
 }
 
+static int ufs_check_resp(utp_utrd_t *utrd, int trans_type, unsigned int timeout_ms)
+{
+	int result;
+
+	result = ufs_wait_for_slot(utrd->task_tag - 1, timeout_ms);
+	if (result != 0) {
+		return result;
+	}
+
+	return ufs_check_utrd(utrd, trans_type);
+}
+
 static void ufs_send_cmd(utp_utrd_t *utrd, uint8_t cmd_op, uint8_t lun, int lba, uintptr_t buf,
 			 size_t length)
 {
@@ -865,14 +983,18 @@ static int ufs_read_capacity(int lun, unsigned int *num, unsigned int *size)
 	return -ETIMEDOUT;
 }
 
-size_t ufs_read_blocks(int lun, int lba, uintptr_t buf, size_t size)
+/* Number of bytes transferred by a completed read or write command */
+static size_t ufs_transferred(utp_utrd_t *utrd, size_t size)
 {
-	utp_utrd_t utrd;
 	resp_upiu_t *resp;
 
-	assert((ufs_params.reg_base != 0) &&
-	       (ufs_params.desc_base != 0) &&
-	       (ufs_params.desc_size >= UFS_DESC_SIZE));
+	resp = (resp_upiu_t *)utrd->resp_upiu;
+	return size - be32toh(resp->res_trans_cnt);
+}
+
+static size_t ufs_read_single(int lun, int lba, uintptr_t buf, size_t size)
+{
+	utp_utrd_t utrd;
 
 	ufs_send_cmd(&utrd, CDBCMD_READ_10, lun, lba, buf, size);
 #ifdef UFS_RESP_DEBUG
@@ -883,14 +1005,201 @@ size_t ufs_read_blocks(int lun, int lba, uintptr_t buf, size_t size)
 	 * accesses the buf.
 	 */
 	inv_dcache_range(buf, size);
-	resp = (resp_upiu_t *)utrd.resp_upiu;
-	return size - resp->res_trans_cnt;
+	return ufs_transferred(&utrd, size);
+}
+
+/*
+ * Read as a sequence of UFS_QUEUED_READ_SIZE reads, keeping up to queue_depth
+ * of them in flight. If one of them fails, the reads in flight are completed
+ * and the rest is read with a single command, retried as needed.
+ */
+static size_t ufs_read_queued(int lun, int lba, uintptr_t buf, size_t size)
+{
+	int tags[UFS_MAX_QUEUE_DEPTH];
+	size_t submitted = 0U, completed = 0U, expected, length;
+	int head = 0, count = 0, result, error = 0;
+	bool short_read = false;
+
+	do {
+		while ((error == 0) && !short_read && (submitted < size) &&
+		       (count < queue_depth)) {
+			length = MIN(size - submitted, (size_t)UFS_QUEUED_READ_SIZE);
+			result = ufs_submit_read_blocks(lun,
+					lba + (int)(submitted >> UFS_BLOCK_SHIFT),
+					buf + submitted, length);
+			if (result < 0) {
+				break;
+			}
+			tags[(head + count) % queue_depth] = result;
+			submitted += length;
+			count++;
+		}
+
+		if (count == 0) {
+			break;
+		}
+
+		/* Reads complete in order, from the head of the queue */
+		expected = MIN(size - completed, (size_t)UFS_QUEUED_READ_SIZE);
+		result = ufs_wait_completion(tags[head], &length);
+		head = (head + 1) % queue_depth;
+		count--;
+
+		if ((error != 0) || short_read) {
+			continue;
+		}
+		if (result != 0) {
+			error = result;
+			continue;
+		}
+		completed += length;
+		short_read = (length != expected);
+	} while (count > 0);
+
+	if ((error != 0) && (completed < size)) {
+		WARN("UFS: queued read failed (%d), reading synchronously\n",
+		     error);
+		completed += ufs_read_single(lun,
+					     lba + (int)(completed >> UFS_BLOCK_SHIFT),
+					     buf + completed, size - completed);
+	}
+
+	return completed;
+}
+
+size_t ufs_read_blocks(int lun, int lba, uintptr_t buf, size_t size)
+{
+	assert((ufs_params.reg_base != 0) &&
+	       (ufs_params.desc_base != 0) &&
+	       (ufs_params.desc_size >= UFS_DESC_SIZE));
+
+	if ((queue_depth > 1) && (size > UFS_QUEUED_READ_SIZE)) {
+		return ufs_read_queued(lun, lba, buf, size);
+	}
+
+	return ufs_read_single(lun, lba, buf, size);
+}
+
+/*
+ * Submit a read without waiting for its completion. Up to UFS_MAX_QUEUE_DEPTH
+ * reads can be in flight at once, 'buf' must not be accessed before the read
+ * is completed with ufs_poll_completion() or ufs_wait_completion().
+ *
+ * Returns the task tag of the read, or -EBUSY if all the slots are in use.
+ */
+int ufs_submit_read_blocks(int lun, int lba, uintptr_t buf, size_t size)
+{
+	ufs_request_t *req;
+	int result, index;
+
+	assert((ufs_params.reg_base != 0) &&
+	       (ufs_params.desc_base != 0) &&
+	       (ufs_params.desc_size >= UFS_DESC_SIZE));
+
+	index = get_free_request();
+	if (index < 0) {
+		return index;
+	}
+
+	req = &requests[index];
+	get_utrd(&req->utrd);
+	assert(req->utrd.task_tag == (index * UTRD_SLOT_STRIDE) + 1);
+	result = ufs_prepare_cmd(&req->utrd, CDBCMD_READ_10, lun, lba, buf,
+				 size);
+	assert(result == 0);
+	req->buf = buf;
+	req->length = size;
+
+	busy_requests |= 1U << index;
+	ufs_send_request(req->utrd.task_tag);
+
+	(void)result;
+	return req->utrd.task_tag;
+}
+
+static ufs_request_t *get_busy_request(int task_tag)
+{
+	int index = (task_tag - 1) / UTRD_SLOT_STRIDE;
+
+	assert((task_tag > 0) && (index < queue_depth) &&
+	       (((task_tag - 1) % UTRD_SLOT_STRIDE) == 0) &&
+	       ((busy_requests & (1U << index)) != 0U));
+
+	return &requests[index];
+}
+
+static int ufs_complete_read(ufs_request_t *req, int result, size_t *length)
+{
+	busy_requests &= ~(1U << ((req->utrd.task_tag - 1) / UTRD_SLOT_STRIDE));
+	if (result != 0) {
+		return result;
+	}
+
+	result = ufs_check_utrd(&req->utrd, RESPONSE_UPIU);
+	if (result != 0) {
+		return result;
+	}
+
+	/*
+	 * Invalidate prefetched cache contents before cpu
+	 * accesses the buf.
+	 */
+	inv_dcache_range(req->buf, req->length);
+	*length = ufs_transferred(&req->utrd, req->length);
+	return 0;
+}
+
+/*
+ * Check whether a read submitted with ufs_submit_read_blocks() has completed.
+ *
+ * Returns
+ * 0 - the read has completed, and 'length' bytes were read
+ * -EBUSY - the read is still in flight
+ * -EIO - fatal error, needs re-init
+ * -EAGAIN - non-fatal error, the read can be submitted again
+ */
+int ufs_poll_completion(int task_tag, size_t *length)
+{
+	ufs_request_t *req;
+	int result;
+
+	assert(length != NULL);
+	req = get_busy_request(task_tag);
+
+	result = ufs_poll_slot(task_tag - 1);
+	if (result == -EBUSY) {
+		return result;
+	}
+	if (result != 0) {
+		mmio_write_32(ufs_params.reg_base + UTRLCLR,
+			      ~(1U << (task_tag - 1)));
+	}
+
+	return ufs_complete_read(req, result, length);
+}
+
+/*
+ * Wait for a read submitted with ufs_submit_read_blocks() to complete.
+ *
+ * Returns the same as ufs_poll_completion(), or -ETIMEDOUT if the read did
+ * not complete in time.
+ */
+int ufs_wait_completion(int task_tag, size_t *length)
+{
+	ufs_request_t *req;
+	int result;
+
+	assert(length != NULL);
+	req = get_busy_request(task_tag);
+
+	result = ufs_wait_for_slot(task_tag - 1, CMD_TIMEOUT_MS);
+
+	return ufs_complete_read(req, result, length);
 }
 
 size_t ufs_write_blocks(int lun, int lba, const uintptr_t buf, size_t size)
 {
 	utp_utrd_t utrd;
-	resp_upiu_t *resp;
 
 	assert((ufs_params.reg_base != 0) &&
 	       (ufs_params.desc_base != 0) &&
@@ -900,8 +1209,7 @@ size_t ufs_write_blocks(int lun, int lba, const uintptr_t buf, size_t size)
 #ifdef UFS_RESP_DEBUG
 	dump_upiu(&utrd);
 #endif
-	resp = (resp_upiu_t *)utrd.resp_upiu;
-	return size - resp->res_trans_cnt;
+	return ufs_transferred(&utrd, size);
 }
 
 static int ufs_set_fdevice_init(void)
@@ -977,6 +1285,42 @@ static void ufs_get_device_info(struct ufs_dev_desc *card_data)
 				     (desc_buf[DEVICE_DESC_PARAM_MANF_ID + 1]));
 }
 
+/*
+ * Lay out the descriptor area. With a single request in flight, its UTRD is
+ * followed by its UTP Command Descriptor (UCD) and PRDT, which can use the
+ * rest of the area. When there is room for several requests, the transfer
+ * request list takes up the first UFS_DESC_SIZE bytes, and the rest is split
+ * into one UCD and PRDT per request.
+ */
+static void ufs_init_queue(void)
+{
+	size_t ucd_area = ufs_params.desc_size - UFS_DESC_SIZE;
+	int depth;
+
+	depth = nutrs / UTRD_SLOT_STRIDE;
+	if (depth > UFS_MAX_QUEUE_DEPTH) {
+		depth = UFS_MAX_QUEUE_DEPTH;
+	}
+	if (depth > (int)(ucd_area / UFS_DESC_SIZE)) {
+		depth = ucd_area / UFS_DESC_SIZE;
+	}
+
+	if (depth > 1) {
+		queue_depth = depth;
+		ucd_base = ufs_params.desc_base + UFS_DESC_SIZE;
+		ucd_size = (ucd_area / depth) & ~CDB_ADDR_MASK;
+	} else {
+		queue_depth = 1;
+		ucd_base = ALIGN_CDB(ufs_params.desc_base + UTP_TRD_SIZE);
+		ucd_size = ufs_params.desc_base + ufs_params.desc_size -
+			   ucd_base;
+	}
+	busy_requests = 0U;
+
+	VERBOSE("UFS: %d transfer request slots, %d used\n", nutrs,
+		queue_depth);
+}
+
 int ufs_init(const ufs_ops_t *ops, ufs_params_t *params)
 {
 	int result;
@@ -993,10 +1337,7 @@ int ufs_init(const ufs_ops_t *ops, ufs_params_t *params)
 
 	/* 0 means 1 slot */
 	nutrs = (mmio_read_32(ufs_params.reg_base + CAP) & CAP_NUTRS_MASK) + 1;
-	if (nutrs > (ufs_params.desc_size / UFS_DESC_SIZE)) {
-		nutrs = ufs_params.desc_size / UFS_DESC_SIZE;
-	}
-
+	ufs_init_queue();
 
 	if (ufs_params.flags & UFS_FLAGS_SKIPINIT) {
 		mmio_write_32(ufs_params.reg_base + UTRLBA,
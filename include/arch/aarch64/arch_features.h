@@ -89,6 +89,12 @@ static inline bool is_armv8_5_bti_present(void)
 		ID_AA64PFR1_EL1_BT_MASK) == BTI_IMPLEMENTED;
 }
 
+static inline bool is_feat_sha256_present(void)
+{
+	return ((read_id_aa64isar0_el1() >> ID_AA64ISAR0_SHA2_SHIFT) &
+		ID_AA64ISAR0_SHA2_MASK) != 0U;
+}
+
 static inline unsigned int get_armv8_5_mte_support(void)
 {
 	return ((read_id_aa64pfr1_el1() >> ID_AA64PFR1_EL1_MTE_SHIFT) &
@@ -238,4 +238,14 @@
 		__XLAT_TABLE_END__ = .;			\
 	}
 
+/*
+ * The .tf_log_fmt section holds the format strings of the tokenized log
+ * messages (ENABLE_TOKENIZED_LOG). They are only read from the ELF file by the
+ * host log decoder, so the section is not allocated in the image.
+ */
+#define TF_LOG_FMT_SECTION				\
+	.tf_log_fmt 0 (INFO) : {			\
+		KEEP(*(.tf_log_fmt))			\
+	}
+
 #endif /* BL_COMMON_LD_H */
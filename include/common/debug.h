@@ -35,6 +35,9 @@
 #include <stdio.h>
 
 #include <drivers/console.h>
+#if ENABLE_TOKENIZED_LOG
+#include <common/tf_log_token.h>
+#endif
 
 /*
  * Define Log Markers corresponding to each log level which will
@@ -59,8 +62,19 @@
 		}					\
 	} while (false)
 
+/*
+ * The log macros below go through tf_log_msg(), which either formats the
+ * message with tf_log() or, with ENABLE_TOKENIZED_LOG, logs its token and raw
+ * arguments (see tf_log_token.h).
+ */
+#if ENABLE_TOKENIZED_LOG
+#define tf_log_msg(...)		tf_log_tokenized(__VA_ARGS__)
+#else
+#define tf_log_msg(...)		tf_log(__VA_ARGS__)
+#endif
+
 #if LOG_LEVEL >= LOG_LEVEL_ERROR
-# define ERROR(...)	tf_log(LOG_MARKER_ERROR __VA_ARGS__)
+# define ERROR(...)	tf_log_msg(LOG_MARKER_ERROR __VA_ARGS__)
 # define ERROR_NL()	tf_log_newline(LOG_MARKER_ERROR)
 #else
 # define ERROR(...)	no_tf_log(LOG_MARKER_ERROR __VA_ARGS__)
@@ -68,25 +82,25 @@
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_NOTICE
-# define NOTICE(...)	tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
+# define NOTICE(...)	tf_log_msg(LOG_MARKER_NOTICE __VA_ARGS__)
 #else
 # define NOTICE(...)	no_tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_WARNING
-# define WARN(...)	tf_log(LOG_MARKER_WARNING __VA_ARGS__)
+# define WARN(...)	tf_log_msg(LOG_MARKER_WARNING __VA_ARGS__)
 #else
 # define WARN(...)	no_tf_log(LOG_MARKER_WARNING __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_INFO
-# define INFO(...)	tf_log(LOG_MARKER_INFO __VA_ARGS__)
+# define INFO(...)	tf_log_msg(LOG_MARKER_INFO __VA_ARGS__)
 #else
 # define INFO(...)	no_tf_log(LOG_MARKER_INFO __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_VERBOSE
-# define VERBOSE(...)	tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
+# define VERBOSE(...)	tf_log_msg(LOG_MARKER_VERBOSE __VA_ARGS__)
 #else
 # define VERBOSE(...)	no_tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
 #endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TF_LOG_TOKEN_H
+#define TF_LOG_TOKEN_H
+
+#include <cdefs.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Tokenized logging (ENABLE_TOKENIZED_LOG=1).
+ *
+ * The log macros of debug.h do not format their messages. Each format string
+ * is replaced by a 32-bit token, its hash computed at compile time, and only
+ * the token and the raw arguments are written to a log buffer in memory. The
+ * format strings are kept in the .tf_log_fmt section of the ELF file, which
+ * is not loaded, so that tools/tflog_decode/tflog_decode.py can turn the
+ * buffer back into text on the host.
+ *
+ * Format strings with a %s conversion are still formatted at runtime, into a
+ * text record, as the string argument cannot be decoded from its address
+ * alone.
+ */
+
+/* Tokens with a special meaning in the log buffer */
+#define TF_LOG_TOKEN_PAD	U(0x00000000)	/* Unused space before a wrap */
+#define TF_LOG_TOKEN_TEXT	U(0xffffffff)	/* Runtime formatted message */
+
+/* "TLOG" */
+#define TF_LOG_BUF_MAGIC	U(0x474f4c54)
+
+/* Maximum number of arguments of a tokenized message */
+#define TF_LOG_TOKEN_MAX_ARGS	16
+
+/*
+ * Only the first TF_LOG_HASH_LEN characters of a format string are hashed,
+ * along with its length. The hash is the 65599 hash also used by the host
+ * decoder:
+ *
+ *   hash = len + sum(fmt[i] * 65599^(i + 1)) mod 2^32
+ *
+ * Each term is a constant expression, so that the compiler folds the whole
+ * sum into the token. A hash equal to one of the special tokens is replaced
+ * with that token XOR 1 when logged.
+ */
+#define TF_LOG_HASH_LEN		80U
+
+#define TF_LOG_HASH_CHAR(fmt, i, k)					\
+	(((i) < (sizeof(fmt) - 1U)) ?					\
+	 ((uint32_t)(k) * (uint8_t)(fmt)[((i) < sizeof(fmt)) ? (i) : 0U]) : 0U)
+
+#define TF_LOG_HASH(fmt)						\
+	((uint32_t)(sizeof(fmt) - 1U) +					\
+	TF_LOG_HASH_CHAR(fmt, 0U, 0x0001003fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 1U, 0x007e0f81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 2U, 0x2e86d0bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 3U, 0x43ec5f01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 4U, 0x162c613fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 5U, 0xd62aee81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 6U, 0xa311b1bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 7U, 0xd319be01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 8U, 0xb156c23fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 9U, 0x6698cd81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 10U, 0x0d1b92bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 11U, 0xcc881d01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 12U, 0x7280233fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 13U, 0x50c7ac81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 14U, 0x8da473bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 15U, 0x4f377c01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 16U, 0xfaa8843fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 17U, 0x33b78b81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 18U, 0x45ac54bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 19U, 0x7a27db01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 20U, 0xeacfe53fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 21U, 0xae686a81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 22U, 0x563335bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 23U, 0x6c593a01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 24U, 0xe3f6463fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 25U, 0x5fda4981U) +			\
+	TF_LOG_HASH_CHAR(fmt, 26U, 0xe03916bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 27U, 0x44cb9901U) +			\
+	TF_LOG_HASH_CHAR(fmt, 28U, 0x871ba73fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 29U, 0xe70d2881U) +			\
+	TF_LOG_HASH_CHAR(fmt, 30U, 0x04bdf7bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 31U, 0x227ef801U) +			\
+	TF_LOG_HASH_CHAR(fmt, 32U, 0x7540083fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 33U, 0xe3010781U) +			\
+	TF_LOG_HASH_CHAR(fmt, 34U, 0xe4c1d8bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 35U, 0x24735701U) +			\
+	TF_LOG_HASH_CHAR(fmt, 36U, 0x4f63693fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 37U, 0xf2b5e681U) +			\
+	TF_LOG_HASH_CHAR(fmt, 38U, 0xa144b9bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 39U, 0x69a8b601U) +			\
+	TF_LOG_HASH_CHAR(fmt, 40U, 0xb685ca3fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 41U, 0xb52bc581U) +			\
+	TF_LOG_HASH_CHAR(fmt, 42U, 0x5b469abfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 43U, 0x111f1501U) +			\
+	TF_LOG_HASH_CHAR(fmt, 44U, 0x4ba72b3fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 45U, 0xc962a481U) +			\
+	TF_LOG_HASH_CHAR(fmt, 46U, 0x33c77bbfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 47U, 0x39d67401U) +			\
+	TF_LOG_HASH_CHAR(fmt, 48U, 0xafc78c3fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 49U, 0xce5a8381U) +			\
+	TF_LOG_HASH_CHAR(fmt, 50U, 0x4bc75cbfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 51U, 0x02ced301U) +			\
+	TF_LOG_HASH_CHAR(fmt, 52U, 0x83e6ed3fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 53U, 0x63136281U) +			\
+	TF_LOG_HASH_CHAR(fmt, 54U, 0xc4463dbfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 55U, 0x8b083201U) +			\
+	TF_LOG_HASH_CHAR(fmt, 56U, 0x69054e3fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 57U, 0x268d4181U) +			\
+	TF_LOG_HASH_CHAR(fmt, 58U, 0xbe441ebfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 59U, 0xf1829101U) +			\
+	TF_LOG_HASH_CHAR(fmt, 60U, 0x0022af3fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 61U, 0xb7c82081U) +			\
+	TF_LOG_HASH_CHAR(fmt, 62U, 0x5ac0ffbfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 63U, 0x553df001U) +			\
+	TF_LOG_HASH_CHAR(fmt, 64U, 0xea3f103fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 65U, 0xb5c3ff81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 66U, 0xbabce0bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 67U, 0xd53a4f01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 68U, 0xc85a713fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 69U, 0xbf80de81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 70U, 0xff37c1bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 71U, 0x9077ae01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 72U, 0x3b74d23fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 73U, 0x73febd81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 74U, 0x4931a2bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 75U, 0xa5f60d01U) +			\
+	TF_LOG_HASH_CHAR(fmt, 76U, 0xe48e333fU) +			\
+	TF_LOG_HASH_CHAR(fmt, 77U, 0x723d9c81U) +			\
+	TF_LOG_HASH_CHAR(fmt, 78U, 0xb9aa83bfU) +			\
+	TF_LOG_HASH_CHAR(fmt, 79U, 0x34b56c01U))
+
+#define TF_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10,	\
+		      _11, _12, _13, _14, _15, _16, n, ...)	n
+#define TF_LOG_NARGS(...)						\
+	TF_LOG_NARGS_(0, ##__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10,	\
+		      9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+/*
+ * Log a message with the format string 'fmt', which starts with a LOG_MARKER_*
+ * as for tf_log(). The format string is stored in the .tf_log_fmt section.
+ * As both calls are compiled, the arguments are still type checked against
+ * it, but only one of them is kept.
+ */
+#define tf_log_tokenized(fmt, ...)					\
+	do {								\
+		static const char tf_log_fmt_str[] __used		\
+			__section(".tf_log_fmt") = fmt;			\
+									\
+		if (__builtin_strstr(fmt, "%s") != NULL) {		\
+			tf_log(fmt, ##__VA_ARGS__);			\
+		} else {						\
+			tf_log_token((fmt)[0], TF_LOG_HASH(fmt),	\
+				     TF_LOG_NARGS(__VA_ARGS__),		\
+				     ##__VA_ARGS__);			\
+		}							\
+	} while (false)
+
+void tf_log_token(unsigned int log_level, uint32_t token, unsigned int nargs,
+		  ...);
+
+#endif /* TF_LOG_TOKEN_H */
@@ -42,6 +42,16 @@ typedef struct auth_img_desc_s {
 } auth_img_desc_t;
 #endif /* COT_DESC_IN_DTB && !IMAGE_BL1 */
 
+#if AUTH_SIG_CACHE
+/*
+ * Size of the memory the platform must provide through
+ * plat_get_auth_sig_cache() to hold 'n' signature cache entries.
+ */
+#define AUTH_SIG_CACHE_DIGEST_SIZE	U(32)
+#define AUTH_SIG_CACHE_ENTRY_SIZE	(U(8) + (2U * AUTH_SIG_CACHE_DIGEST_SIZE))
+#define AUTH_SIG_CACHE_SIZE(n)		(U(8) + ((n) * AUTH_SIG_CACHE_ENTRY_SIZE))
+#endif /* AUTH_SIG_CACHE */
+
 /* Public functions */
 #if TRUSTED_BOARD_BOOT
 void auth_mod_init(void);
@@ -54,6 +64,9 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id);
 int auth_mod_verify_img(unsigned int img_id,
 			void *img_ptr,
 			unsigned int img_len);
+int auth_mod_get_img_digest_info(unsigned int img_id, const void *img_ptr,
+				 unsigned int img_len, void **digest_info_ptr,
+				 unsigned int *digest_info_len);
 
 /* Macro to register a CoT defined as an array of auth_img_desc_t pointers */
 #define REGISTER_COT(_cot) \
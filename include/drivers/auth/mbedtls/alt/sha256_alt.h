@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SHA256_ALT_H
+#define SHA256_ALT_H
+
+#include <stdint.h>
+
+/*
+ * SHA-256 context of the MBEDTLS_SHA256_ALT implementation in
+ * drivers/auth/mbedtls/mbedtls_sha256.c.
+ */
+typedef struct mbedtls_sha256_context {
+	uint64_t total;		/* Number of bytes processed */
+	uint32_t state[8];	/* Intermediate digest state */
+	unsigned char buffer[64];	/* Data block being processed */
+	int is224;		/* 1 for SHA-224, 0 for SHA-256 */
+} mbedtls_sha256_context;
+
+#endif /* SHA256_ALT_H */
@@ -76,6 +76,10 @@
 /* The library does not currently support enabling SHA-256 without SHA-224. */
 #define MBEDTLS_SHA224_C
 #define MBEDTLS_SHA256_C
+#if TF_MBEDTLS_SHA256_A64
+/* Provided by drivers/auth/mbedtls/mbedtls_sha256.c and alt/sha256_alt.h */
+#define MBEDTLS_SHA256_ALT
+#endif
 /*
  * If either Trusted Boot or Measured Boot require a stronger algorithm than
  * SHA-256, pull in SHA-512 support. Library currently needs to have SHA_384
@@ -87,8 +87,22 @@ int console_putc(int c);
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
 #endif
-/* Flush all consoles registered for the current state. */
+/*
+ * Flush all consoles registered for the current state, after outputting the
+ * characters buffered by the calling CPU.
+ */
 void console_flush(void);
+#if ENABLE_CONSOLE_LOG_BUFFER
+/*
+ * Output the characters buffered by the calling CPU on all consoles
+ * registered for the current state, without waiting for them to be sent.
+ */
+void console_log_drain(void);
+#else
+static inline void console_log_drain(void)
+{
+}
+#endif
 
 #endif /* __ASSEMBLER__ */
 
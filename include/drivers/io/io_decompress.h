@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef IO_DECOMPRESS_H
+#define IO_DECOMPRESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct io_dev_connector;
+
+/*
+ * Streaming decompressor used by the decompression IO driver.
+ *
+ * @tail_len: number of bytes at the end of the compressed stream that
+ *	get_size() needs (e.g. the gzip ISIZE field), or 0.
+ * @get_size: return the decompressed size of the stream, given the first
+ *	head_len bytes of it and the last tail_len bytes.
+ * @start: reset the decompressor state, using the given workspace.
+ * @run: decompress from *in_buf to *out_buf, advancing both and reducing
+ *	*in_len and *out_len by the amount consumed and produced. The output
+ *	of successive calls must be contiguous. Return 1 at the end of the
+ *	stream, 0 if more input or output space is needed and a negative
+ *	error code otherwise.
+ */
+typedef struct io_decompressor {
+	size_t tail_len;
+	int (*get_size)(const uint8_t *head, size_t head_len,
+			const uint8_t *tail, size_t *size);
+	int (*start)(uintptr_t work_buf, size_t work_len);
+	int (*run)(uintptr_t *in_buf, size_t *in_len,
+		   uintptr_t *out_buf, size_t *out_len);
+} io_decompressor_t;
+
+int register_io_dev_decompress(const struct io_dev_connector **dev_con);
+void io_decompress_init(uintptr_t work_base, size_t work_size,
+			const io_decompressor_t *decompressor);
+
+#endif /* IO_DECOMPRESS_H */
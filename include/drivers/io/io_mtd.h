@@ -54,6 +54,17 @@ typedef struct io_mtd_ops {
 	 * Return 0 on success, a negative error code otherwise.
 	 */
 	int (*seek)(uintptr_t base, unsigned int offset, size_t *extra_offset);
+
+	/*
+	 * Optional: map an area through the memory-mapped window of the
+	 * device. The mapping is valid until the next operation on the device.
+	 *
+	 * @offset: Offset in bytes of the area.
+	 * @length: Length of the area in bytes.
+	 * @address: [out] Address at which the area is mapped.
+	 * Return 0 on success, a negative error code otherwise.
+	 */
+	int (*map)(unsigned int offset, size_t length, uintptr_t *address);
 } io_mtd_ops_t;
 
 typedef struct io_mtd_dev_spec {
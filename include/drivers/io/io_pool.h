@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef IO_POOL_H
+#define IO_POOL_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/cassert.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+
+/*
+ * Pool of statically allocated IO objects (entities, file states...), which
+ * are allocated and released in constant time, unlike the objects of
+ * object_pool.h which are never released.
+ *
+ * The objects are handed out in order the first time, and the released ones
+ * are kept in a free list, linked through their first word. The objects must
+ * therefore be at least pointer sized and aligned. A pool holds at most
+ * IO_POOL_MAX_OBJECTS objects, whose allocation state is tracked in a bitmap
+ * so that releasing an object twice cannot corrupt the free list.
+ */
+typedef struct io_pool {
+	/* Objects back store. */
+	void *const objects;
+
+	/* Size of 1 object in the pool in byte unit. */
+	const size_t obj_size;
+
+	/* Number of objects in the pool. */
+	const unsigned int capacity;
+
+	/* Number of objects handed out at least once. */
+	unsigned int used;
+
+	/* Released objects. */
+	void *free_list;
+
+	/* Bitmap of the objects currently allocated. */
+	uint64_t allocated;
+} io_pool_t;
+
+/* Maximum number of objects in a pool, one per bit of 'allocated'. */
+#define IO_POOL_MAX_OBJECTS		U(64)
+
+/*
+ * Create a pool of objects out of an array of pre-allocated objects. The
+ * array size is checked against IO_POOL_MAX_OBJECTS at build time.
+ */
+#define IO_POOL_ARRAY(_pool_name, _obj_array)				\
+	io_pool_t _pool_name = {					\
+		.objects = (_obj_array),				\
+		.obj_size = sizeof((_obj_array)[0]),			\
+		.capacity = ARRAY_SIZE(_obj_array),			\
+		.used = 0U,						\
+		.free_list = NULL,					\
+		.allocated = 0ULL,					\
+	};								\
+	CASSERT(ARRAY_SIZE(_obj_array) <= IO_POOL_MAX_OBJECTS,		\
+		assert_##_pool_name##_capacity)
+
+static inline bool io_pool_contains(const io_pool_t *pool, const void *obj)
+{
+	uintptr_t base = (uintptr_t)pool->objects;
+	uintptr_t addr = (uintptr_t)obj;
+
+	return (addr >= base) &&
+	       (addr < (base + (pool->obj_size * pool->capacity))) &&
+	       (((addr - base) % pool->obj_size) == 0U);
+}
+
+static inline uint64_t io_pool_obj_bit(const io_pool_t *pool, const void *obj)
+{
+	return BIT_64(((uintptr_t)obj - (uintptr_t)pool->objects) /
+		      pool->obj_size);
+}
+
+/* Return whether an object of a pool is currently allocated. */
+static inline bool io_pool_is_allocated(const io_pool_t *pool, const void *obj)
+{
+	return io_pool_contains(pool, obj) &&
+	       ((pool->allocated & io_pool_obj_bit(pool, obj)) != 0ULL);
+}
+
+/*
+ * Allocate 1 object from a pool, cleared to zero.
+ * Return the address of the object, or NULL if the pool is exhausted.
+ */
+static inline void *io_pool_alloc(io_pool_t *pool)
+{
+	void *obj = pool->free_list;
+
+	assert(pool->obj_size >= sizeof(void *));
+
+	if (obj != NULL) {
+		pool->free_list = *(void **)obj;
+	} else if (pool->used < pool->capacity) {
+		obj = (char *)pool->objects + (pool->obj_size * pool->used);
+		pool->used++;
+	} else {
+		return NULL;
+	}
+
+	zeromem(obj, pool->obj_size);
+	pool->allocated |= io_pool_obj_bit(pool, obj);
+
+	return obj;
+}
+
+/*
+ * Release an object allocated from a pool. Releasing an object that is not
+ * allocated, e.g. twice, is ignored.
+ */
+static inline void io_pool_free(io_pool_t *pool, void *obj)
+{
+	assert(io_pool_contains(pool, obj));
+	assert(((uintptr_t)obj % sizeof(void *)) == 0U);
+
+	if (!io_pool_is_allocated(pool, obj)) {
+		return;
+	}
+
+	pool->allocated &= ~io_pool_obj_bit(pool, obj);
+	*(void **)obj = pool->free_list;
+	pool->free_list = obj;
+}
+
+#endif /* IO_POOL_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,8 +7,21 @@
 #ifndef IO_SEMIHOSTING_H
 #define IO_SEMIHOSTING_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 struct io_dev_connector;
 
+/*
+ * Optional specification of the semihosting device, given to io_dev_open().
+ * The files opened for reading are then loaded whole in the cache memory the
+ * first time, and served from it afterwards without trapping to the host.
+ */
+typedef struct io_sh_dev_spec {
+	uintptr_t cache_base;
+	size_t cache_size;
+} io_sh_dev_spec_t;
+
 int register_io_dev_sh(const struct io_dev_connector **dev_con);
 
 #endif /* IO_SEMIHOSTING_H */
@@ -24,6 +24,7 @@ typedef enum {
 	IO_TYPE_MTD,
 	IO_TYPE_MMC,
 	IO_TYPE_ENCRYPTED,
+	IO_TYPE_DECOMPRESS,
 	IO_TYPE_MAX
 } io_type_t;
 
@@ -93,6 +94,13 @@ int io_size(uintptr_t handle, size_t *length);
 int io_read(uintptr_t handle, uintptr_t buffer, size_t length,
 		size_t *length_read);
 
+/*
+ * Return the address at which the data of an entity, from its current
+ * position to its end, can be read directly in memory. Fails with -ENODEV if
+ * the entity is not memory mapped.
+ */
+int io_map(uintptr_t handle, uintptr_t *address);
+
 int io_write(uintptr_t handle, const uintptr_t buffer, size_t length,
 		size_t *length_written);
 
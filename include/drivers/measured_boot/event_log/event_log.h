@@ -94,6 +94,20 @@ typedef struct {
 	unsigned int pcr;
 } event_log_metadata_t;
 
+/*
+ * Event Log usage counters
+ *
+ * @events_recorded:	Number of events written since initialisation
+ * @bytes_hashed:	Amount of data hashed by the Event Log driver
+ * @hashes_reused:	Number of measurements which reused the digest computed
+ *			during image authentication instead of hashing again
+ */
+typedef struct {
+	uint32_t events_recorded;
+	uint64_t bytes_hashed;
+	uint32_t hashes_reused;
+} event_log_stats_t;
+
 #define	ID_EVENT_SIZE	(sizeof(id_event_headers_t) + \
 			(sizeof(id_event_algorithm_size_t) * HASH_ALG_COUNT) + \
 			sizeof(id_event_struct_data_t))
@@ -122,6 +136,9 @@ void event_log_record(const uint8_t *hash, uint32_t event_type,
 int event_log_measure_and_record(uintptr_t data_base, uint32_t data_size,
 				 uint32_t data_id,
 				 const event_log_metadata_t *metadata_ptr);
+void event_log_record_hash(const unsigned char *hash_data, uint32_t data_id,
+			   const event_log_metadata_t *metadata_ptr);
 size_t event_log_get_cur_size(uint8_t *event_log_start);
+void event_log_get_stats(event_log_stats_t *stats);
 
 #endif /* EVENT_LOG_H */
@@ -138,6 +138,13 @@ struct mmc_ops {
 	int (*prepare)(int lba, uintptr_t buf, size_t size);
 	int (*read)(int lba, uintptr_t buf, size_t size);
 	int (*write)(int lba, const uintptr_t buf, size_t size);
+	/*
+	 * Optional: check without waiting whether the data transfer of the
+	 * read command in flight is over. Return 0 if it is, -EAGAIN if it is
+	 * still in progress, another negative error code on transfer error.
+	 * read() is still called once the transfer is over.
+	 */
+	int (*read_done)(int lba, uintptr_t buf, size_t size);
 };
 
 struct mmc_csd_emmc {
@@ -259,6 +266,9 @@ struct mmc_device_info {
 };
 
 size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size);
+int mmc_submit_read_blocks(int lba, uintptr_t buf, size_t size);
+int mmc_poll_read_blocks(void);
+int mmc_wait_read_blocks(void);
 size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size);
 size_t mmc_erase_blocks(int lba, size_t size);
 int mmc_part_switch_current_boot(void);
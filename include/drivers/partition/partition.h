@@ -27,6 +27,14 @@ CASSERT((PLAT_PARTITION_BLOCK_SIZE == 512) ||
 	(PLAT_PARTITION_BLOCK_SIZE == 4096),
 	assert_plat_partition_block_size);
 
+#if !PLAT_PARTITION_READ_BLOCKS
+# if PLAT_PARTITION_BLOCK_SIZE == 512
+#  define PLAT_PARTITION_READ_BLOCKS	4
+# else
+#  define PLAT_PARTITION_READ_BLOCKS	1
+# endif
+#endif /* PLAT_PARTITION_READ_BLOCKS */
+
 #define LEGACY_PARTITION_BLOCK_SIZE	512
 
 #define LBA(n) ((unsigned long long)(n) * PLAT_PARTITION_BLOCK_SIZE)
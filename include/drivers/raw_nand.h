@@ -66,6 +66,8 @@
 #define NAND_CMD_CHANGE_1ST		0x05U
 #define NAND_CMD_READID_SIG_ADDR	0x20U
 #define NAND_CMD_READ_2ND		0x30U
+#define NAND_CMD_READ_CACHE_SEQ		0x31U
+#define NAND_CMD_READ_CACHE_END		0x3FU
 #define NAND_CMD_STATUS			0x70U
 #define NAND_CMD_READID			0x90U
 #define NAND_CMD_CHANGE_2ND		0xE0U
@@ -75,6 +77,7 @@
 #define ONFI_REV_21			BIT(3)
 #define ONFI_FEAT_BUS_WIDTH_16		BIT(0)
 #define ONFI_FEAT_EXTENDED_PARAM	BIT(7)
+#define ONFI_OPT_CMD_READ_CACHE		BIT(1)
 
 /* NAND ECC type */
 #define NAND_ECC_NONE			U(0)
@@ -163,9 +166,13 @@ struct nand_ctrl_ops {
 	void (*setup)(struct nand_device *nand);
 };
 
+/* Flags for specific configuration */
+#define RAW_NAND_HAS_READ_CACHE		BIT(0)
+
 struct rawnand_device {
 	struct nand_device *nand_dev;
 	const struct nand_ctrl_ops *ops;
+	uint32_t flags;
 };
 
 int nand_raw_init(unsigned long long *size, unsigned int *erase_size);
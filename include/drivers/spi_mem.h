@@ -121,9 +121,34 @@ struct spi_bus_ops {
 	 * Returns: 0 on success, a negative error code otherwise.
 	 */
 	int (*exec_op)(const struct spi_mem_op *op);
+
+	/*
+	 * Optional: execute a SPI memory read operation through the
+	 * memory-mapped window of the controller.
+	 *
+	 * @op:	The memory read operation to execute.
+	 * Returns: 0 on success, -ENOTSUP if the operation cannot be executed
+	 * through the window, another negative error code otherwise.
+	 */
+	int (*dirmap_read)(const struct spi_mem_op *op);
+
+	/*
+	 * Optional: leave the memory-mapped window of the controller enabled
+	 * for a SPI memory read operation, so that its data can be read
+	 * directly. The window stays valid until the next operation on the bus.
+	 *
+	 * @op:	The memory read operation, addr.val and data.nbytes give the
+	 *	area to map.
+	 * @address: [out] Address at which the data at addr.val is mapped.
+	 * Returns: 0 on success, -ENOTSUP if the area cannot be mapped, another
+	 * negative error code otherwise.
+	 */
+	int (*dirmap_map)(const struct spi_mem_op *op, uintptr_t *address);
 };
 
 int spi_mem_exec_op(const struct spi_mem_op *op);
+int spi_mem_dirmap_read(const struct spi_mem_op *op);
+int spi_mem_dirmap_map(const struct spi_mem_op *op, uintptr_t *address);
 int spi_mem_init_slave(void *fdt, int bus_node,
 		       const struct spi_bus_ops *ops);
 
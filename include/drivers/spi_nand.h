@@ -14,6 +14,8 @@
 #define SPI_NAND_OP_SET_FEATURE		0x1FU
 #define SPI_NAND_OP_READ_ID		0x9FU
 #define SPI_NAND_OP_LOAD_PAGE		0x13U
+#define SPI_NAND_OP_READ_CACHE_SEQ	0x31U
+#define SPI_NAND_OP_READ_CACHE_END	0x3FU
 #define SPI_NAND_OP_RESET		0xFFU
 #define SPI_NAND_OP_READ_FROM_CACHE	0x03U
 #define SPI_NAND_OP_READ_FROM_CACHE_2X	0x3BU
@@ -31,6 +33,7 @@
 
 /* Flags for specific configuration */
 #define SPI_NAND_HAS_QE_BIT		BIT(0)
+#define SPI_NAND_HAS_READ_CACHE		BIT(1)
 
 struct spinand_device {
 	struct nand_device *nand_dev;
@@ -30,6 +30,14 @@
 #define SPI_NOR_OP_READ_1_1_4	0x6BU	/* Read data bytes (Quad Output SPI) */
 #define SPI_NOR_OP_READ_1_4_4	0xEBU	/* Read data bytes (Quad I/O SPI) */
 
+/* Read opcodes taking a 4-byte address */
+#define SPI_NOR_OP_READ_4B	0x13U	/* Read data bytes (low frequency) */
+#define SPI_NOR_OP_READ_FAST_4B	0x0CU	/* Read data bytes (high frequency) */
+#define SPI_NOR_OP_READ_1_1_2_4B 0x3CU	/* Read data bytes (Dual Output SPI) */
+#define SPI_NOR_OP_READ_1_2_2_4B 0xBCU	/* Read data bytes (Dual I/O SPI) */
+#define SPI_NOR_OP_READ_1_1_4_4B 0x6CU	/* Read data bytes (Quad Output SPI) */
+#define SPI_NOR_OP_READ_1_4_4_4B 0xECU	/* Read data bytes (Quad I/O SPI) */
+
 /* Flags for NOR specific configuration */
 #define SPI_NOR_USE_FSR		BIT(0)
 #define SPI_NOR_USE_BANK	BIT(1)
@@ -47,6 +55,27 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 		 size_t *length_read);
 int spi_nor_init(unsigned long long *device_size, unsigned int *erase_size);
 
+/*
+ * Map a NOR area through the memory-mapped window of the SPI controller.
+ * The mapping is valid until the next operation on the bus.
+ *
+ * @offset: offset of the area in the device.
+ * @length: length of the area.
+ * @address: [out] address at which the area is mapped.
+ * Return 0 on success, -ENOTSUP if the area cannot be mapped, negative value
+ * otherwise.
+ */
+int spi_nor_map(unsigned int offset, size_t length, uintptr_t *address);
+
+/*
+ * Reset the bank register to the first bank. The bank register is kept
+ * across reads, the platform calls this once before handing over to the
+ * next boot stage.
+ *
+ * Return 0 on success, negative value otherwise.
+ */
+int spi_nor_clean_bar(void);
+
 /*
  * Platform can implement this to override default NOR instance configuration.
  *
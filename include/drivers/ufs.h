@@ -134,6 +134,16 @@
 #define UFS_BLOCK_MASK			(UFS_BLOCK_SIZE - 1)
 #define UFS_MAX_LUNS			8
 
+/*
+ * Maximum number of transfer requests in flight, for reads queued with
+ * ufs_submit_read_blocks() and by ufs_read_blocks(). It is further limited by
+ * the number of slots of the controller and by the size of the descriptor
+ * area: 1KB for the transfer request list, and at least 1KB per request.
+ */
+#ifndef UFS_MAX_QUEUE_DEPTH
+#define UFS_MAX_QUEUE_DEPTH		8
+#endif
+
 /* UTP Transfer Request Descriptor */
 /* Command Type */
 #define CT_UFS_STORAGE			1
@@ -584,6 +594,9 @@ void ufs_read_desc(int idn, int index, uintptr_t buf, size_t size);
 void ufs_write_desc(int idn, int index, uintptr_t buf, size_t size);
 size_t ufs_read_blocks(int lun, int lba, uintptr_t buf, size_t size);
 size_t ufs_write_blocks(int lun, int lba, const uintptr_t buf, size_t size);
+int ufs_submit_read_blocks(int lun, int lba, uintptr_t buf, size_t size);
+int ufs_poll_completion(int task_tag, size_t *length);
+int ufs_wait_completion(int task_tag, size_t *length);
 int ufs_init(const ufs_ops_t *ops, ufs_params_t *params);
 
 #endif /* UFS_H */
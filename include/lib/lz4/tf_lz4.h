@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TF_LZ4_H
+#define TF_LZ4_H
+
+struct io_decompressor;
+
+/* Streaming LZ4 frame decompressor for the decompression IO driver */
+extern const struct io_decompressor lz4_io_decompressor;
+
+#endif /* TF_LZ4_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2014, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -39,6 +39,7 @@
 #define FOPEN_MODE_APLUSB		0xb
 
 long semihosting_connection_supported(void);
+unsigned long semihosting_trap_count(void);
 long semihosting_file_open(const char *file_name, size_t mode);
 long semihosting_file_seek(long file_handle, ssize_t offset);
 long semihosting_file_read(long file_handle, size_t *length, uintptr_t buffer);
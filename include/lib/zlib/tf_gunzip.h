@@ -10,6 +10,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+struct io_decompressor;
+
+/* Streaming gzip decompressor for the decompression IO driver */
+extern const struct io_decompressor gunzip_io_decompressor;
+
 int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	   size_t out_len, uintptr_t work_buf, size_t work_len);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,11 +7,30 @@
 #ifndef SPMD_SVC_H
 #define SPMD_SVC_H
 
+#include <lib/utils_def.h>
+
+/*
+ * SiP function ID of the batched memory reclaim. It is implementation defined,
+ * and only serviced by the SPMC at EL3 for the normal world. Platforms route
+ * it to spmd_sip_smc_handler() from their SiP service.
+ */
+#define SPMD_SIP_MEM_RECLAIM_BATCH	U(0x82000070)
+
+#define is_spmd_sip_fid(_fid)		((_fid) == SPMD_SIP_MEM_RECLAIM_BATCH)
+
 #ifndef __ASSEMBLER__
 #include <services/ffa_svc.h>
 #include <stdint.h>
 
 int spmd_setup(void);
+uint64_t spmd_sip_smc_handler(uint32_t smc_fid,
+			      uint64_t x1,
+			      uint64_t x2,
+			      uint64_t x3,
+			      uint64_t x4,
+			      void *cookie,
+			      void *handle,
+			      uint64_t flags);
 uint64_t spmd_ffa_smc_handler(uint32_t smc_fid,
 			      uint64_t x1,
 			      uint64_t x2,
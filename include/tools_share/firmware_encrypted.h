@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Linaro Limited. All rights reserved.
+ * Copyright (c) 2020-2023, Linaro Limited. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -16,6 +16,20 @@
 /* Firmware encryption status flag mask */
 #define FW_ENC_STATUS_FLAG_MASK		0x1
 
+/*
+ * log2 of the chunk size of a chunked payload. Zero means the payload is a
+ * single GCM message authenticated by the tag in the header. Otherwise the
+ * payload is a sequence of chunks, each made of up to (1 << shift) bytes of
+ * ciphertext followed by its own tag, so that each chunk can be decrypted as
+ * soon as it has been read.
+ */
+#define FW_ENC_CHUNK_SHIFT_SHIFT	8
+#define FW_ENC_CHUNK_SHIFT_MASK		0xff
+#define FW_ENC_CHUNK_SHIFT(flags)	\
+	(((flags) >> FW_ENC_CHUNK_SHIFT_SHIFT) & FW_ENC_CHUNK_SHIFT_MASK)
+#define FW_ENC_CHUNK_SHIFT_MIN		9
+#define FW_ENC_CHUNK_SHIFT_MAX		24
+
 /*
  * SSK: Secret Symmetric Key
  * BSSK: Binding Secret Symmetric Key
@@ -39,4 +53,30 @@ struct fw_enc_hdr {
 	uint8_t tag[ENC_MAX_TAG_SIZE];
 };
 
+/*
+ * IV of chunk 'idx' of a chunked payload: the chunk index is XORed into the
+ * last four bytes of the IV from the header and the top bit of the byte
+ * before them is flipped for the last chunk, so that chunks can neither be
+ * reordered nor dropped from the end.
+ */
+static inline void fw_enc_chunk_iv(uint8_t *iv, const uint8_t *hdr_iv,
+				   unsigned int iv_len, uint32_t idx,
+				   int last)
+{
+	unsigned int i;
+
+	for (i = 0U; i < iv_len; i++) {
+		iv[i] = hdr_iv[i];
+	}
+
+	iv[iv_len - 4U] ^= (uint8_t)(idx >> 24);
+	iv[iv_len - 3U] ^= (uint8_t)(idx >> 16);
+	iv[iv_len - 2U] ^= (uint8_t)(idx >> 8);
+	iv[iv_len - 1U] ^= (uint8_t)idx;
+
+	if (last != 0) {
+		iv[iv_len - 5U] ^= 0x80U;
+	}
+}
+
 #endif /* FIRMWARE_ENCRYPTED_H */
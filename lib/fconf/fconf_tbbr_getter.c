@@ -71,6 +71,18 @@ int fconf_populate_tbbr_dyn_config(uintptr_t config)
 	}
 	tbbr_dyn_config.mbedtls_heap_size = val32;
 
+#if AUTH_SIG_CACHE
+	/*
+	 * The signature cache shared by BL1 is optional: BL2 verifies all
+	 * signatures itself if it is absent.
+	 */
+	if ((fdt_read_uint64(dtb, node, "auth_sig_cache_addr", &val64) == 0) &&
+	    (fdt_read_uint32(dtb, node, "auth_sig_cache_size", &val32) == 0)) {
+		tbbr_dyn_config.auth_sig_cache_addr = (void *)(uintptr_t)val64;
+		tbbr_dyn_config.auth_sig_cache_size = val32;
+	}
+#endif /* AUTH_SIG_CACHE */
+
 	VERBOSE("%s%s%s %u\n", "FCONF: `tbbr.", "disable_auth",
 		"` cell found with value =", tbbr_dyn_config.disable_auth);
 	VERBOSE("%s%s%s %p\n", "FCONF: `tbbr.", "mbedtls_heap_addr",
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <drivers/io/io_decompress.h>
+#include <lib/utils_def.h>
+#include <tf_lz4.h>
+
+/*
+ * Streaming decoder for the LZ4 frame format, as produced by
+ * "lz4 --content-size". The frame must carry the content size, and must not
+ * depend on a dictionary. Block and content checksums are skipped, not
+ * verified: the integrity of the image is expected to be covered by Trusted
+ * Board Boot.
+ *
+ * Matches are resolved against the data already written to the output, so
+ * the output must be a single contiguous buffer across calls. No workspace
+ * is needed.
+ */
+
+#define LZ4F_MAGIC			U(0x184D2204)
+
+#define LZ4F_FLG_VERSION_MASK		U(0xc0)
+#define LZ4F_FLG_VERSION		U(0x40)
+#define LZ4F_FLG_BLOCK_CSUM		BIT_32(4)
+#define LZ4F_FLG_CONTENT_SIZE		BIT_32(3)
+#define LZ4F_FLG_CONTENT_CSUM		BIT_32(2)
+#define LZ4F_FLG_RESERVED		BIT_32(1)
+#define LZ4F_FLG_DICT_ID		BIT_32(0)
+
+#define LZ4F_BD_RESERVED		U(0x8f)
+
+/* Magic, FLG and BD: enough to work out the length of the header */
+#define LZ4F_HDR_MIN			U(6)
+/* Magic, FLG, BD, content size and header checksum */
+#define LZ4F_HDR_MAX			U(15)
+
+#define LZ4F_BLOCK_UNCOMPRESSED		BIT_32(31)
+
+#define LZ4_MIN_MATCH			U(4)
+#define LZ4_RUN_MASK			U(15)
+
+enum lz4_state {
+	LZ4_HEADER,
+	LZ4_BLOCK_SIZE,
+	LZ4_RAW,
+	LZ4_TOKEN,
+	LZ4_LIT_LEN,
+	LZ4_LITERALS,
+	LZ4_OFFSET,
+	LZ4_MATCH_LEN,
+	LZ4_MATCH,
+	LZ4_BLOCK_CSUM,
+	LZ4_CONTENT_CSUM,
+	LZ4_DONE,
+};
+
+static struct {
+	enum lz4_state state;
+	uint8_t flg;
+	uint8_t hdr[LZ4F_HDR_MAX];
+	unsigned int hdr_pos;
+	unsigned int hdr_len;
+	uint32_t field;			/* little-endian field being read */
+	unsigned int field_pos;
+	unsigned int field_len;
+	uint32_t blk_left;		/* input bytes left in the block */
+	size_t lit_len;
+	size_t match_len;
+	size_t offset;
+	bool out_set;
+	uintptr_t out_start;		/* start of the decompressed image */
+	uintptr_t out_next;		/* where the next call must write */
+} lz4;
+
+/* Check the start of a frame header and return the length of the header */
+static int lz4_parse_header(const uint8_t *hdr, unsigned int *hdr_len)
+{
+	uint32_t magic = (uint32_t)hdr[0] | ((uint32_t)hdr[1] << 8) |
+			 ((uint32_t)hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+	uint8_t flg = hdr[4];
+	uint8_t bd = hdr[5];
+
+	if (magic != LZ4F_MAGIC) {
+		return -EINVAL;
+	}
+
+	if (((flg & LZ4F_FLG_VERSION_MASK) != LZ4F_FLG_VERSION) ||
+	    ((flg & LZ4F_FLG_RESERVED) != 0U) ||
+	    ((bd & LZ4F_BD_RESERVED) != 0U)) {
+		return -EINVAL;
+	}
+
+	if ((flg & LZ4F_FLG_DICT_ID) != 0U) {
+		ERROR("lz4: dictionaries are not supported\n");
+		return -ENOTSUP;
+	}
+
+	*hdr_len = LZ4F_HDR_MIN + 1U;
+	if ((flg & LZ4F_FLG_CONTENT_SIZE) != 0U) {
+		*hdr_len += 8U;
+	}
+
+	return 0;
+}
+
+static int lz4_io_get_size(const uint8_t *head, size_t head_len,
+			   const uint8_t *tail, size_t *size)
+{
+	unsigned int hdr_len;
+	uint64_t content_size = 0U;
+	unsigned int i;
+	int ret;
+
+	if (head_len < LZ4F_HDR_MIN) {
+		return -EINVAL;
+	}
+
+	ret = lz4_parse_header(head, &hdr_len);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if ((head[4] & LZ4F_FLG_CONTENT_SIZE) == 0U) {
+		ERROR("lz4: frame does not record the content size\n");
+		return -ENOTSUP;
+	}
+
+	if (head_len < hdr_len) {
+		return -EINVAL;
+	}
+
+	for (i = 0U; i < 8U; i++) {
+		content_size |= (uint64_t)head[LZ4F_HDR_MIN + i] << (8U * i);
+	}
+
+	if (content_size > SIZE_MAX) {
+		return -EFBIG;
+	}
+
+	*size = (size_t)content_size;
+
+	return 0;
+}
+
+static int lz4_io_start(uintptr_t work_buf, size_t work_len)
+{
+	memset(&lz4, 0, sizeof(lz4));
+	lz4.state = LZ4_HEADER;
+	lz4.hdr_len = LZ4F_HDR_MIN;
+
+	return 0;
+}
+
+/* Start reading a little-endian field of 'len' bytes */
+static void lz4_field_start(unsigned int len, enum lz4_state state)
+{
+	lz4.field = 0U;
+	lz4.field_pos = 0U;
+	lz4.field_len = len;
+	lz4.state = state;
+}
+
+/*
+ * Read the next bytes of the current field, accounting them to the current
+ * block if 'in_block'. Return 1 once the field is complete, 0 if more input
+ * is needed and -EINVAL if the field overruns the block.
+ */
+static int lz4_field_read(const uint8_t **in, const uint8_t *in_end,
+			  bool in_block)
+{
+	while (lz4.field_pos < lz4.field_len) {
+		if (in_block && (lz4.blk_left == 0U)) {
+			return -EINVAL;
+		}
+		if (*in == in_end) {
+			return 0;
+		}
+		lz4.field |= (uint32_t)*(*in)++ << (8U * lz4.field_pos++);
+		if (in_block) {
+			lz4.blk_left--;
+		}
+	}
+
+	return 1;
+}
+
+/* Read one length byte of the current block, 0 if more input is needed */
+static int lz4_len_byte(const uint8_t **in, const uint8_t *in_end,
+			uint8_t *byte)
+{
+	if (lz4.blk_left == 0U) {
+		return -EINVAL;
+	}
+	if (*in == in_end) {
+		return 0;
+	}
+
+	*byte = *(*in)++;
+	lz4.blk_left--;
+
+	return 1;
+}
+
+static void lz4_block_end(void)
+{
+	if ((lz4.flg & LZ4F_FLG_BLOCK_CSUM) != 0U) {
+		lz4_field_start(4U, LZ4_BLOCK_CSUM);
+	} else {
+		lz4_field_start(4U, LZ4_BLOCK_SIZE);
+	}
+}
+
+static size_t lz4_min(size_t a, size_t b)
+{
+	return (a < b) ? a : b;
+}
+
+static int lz4_decode(const uint8_t **inp, const uint8_t *in_end,
+		      uint8_t **outp, uint8_t *out_end)
+{
+	const uint8_t *in = *inp;
+	uint8_t *out = *outp;
+	uint8_t byte;
+	size_t n;
+	int ret = 0;
+
+	while (ret == 0) {
+		switch (lz4.state) {
+		case LZ4_HEADER:
+			if (in == in_end) {
+				goto out;
+			}
+			lz4.hdr[lz4.hdr_pos++] = *in++;
+			if (lz4.hdr_pos == LZ4F_HDR_MIN) {
+				ret = lz4_parse_header(lz4.hdr, &lz4.hdr_len);
+				lz4.flg = lz4.hdr[4];
+			}
+			if (lz4.hdr_pos == lz4.hdr_len) {
+				lz4_field_start(4U, LZ4_BLOCK_SIZE);
+			}
+			break;
+
+		case LZ4_BLOCK_SIZE:
+			ret = lz4_field_read(&in, in_end, false);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			if (lz4.field == 0U) {
+				/* EndMark */
+				if ((lz4.flg & LZ4F_FLG_CONTENT_CSUM) != 0U) {
+					lz4_field_start(4U, LZ4_CONTENT_CSUM);
+				} else {
+					lz4.state = LZ4_DONE;
+				}
+				break;
+			}
+			lz4.blk_left = lz4.field & ~LZ4F_BLOCK_UNCOMPRESSED;
+			if ((lz4.field & LZ4F_BLOCK_UNCOMPRESSED) != 0U) {
+				lz4.state = LZ4_RAW;
+			} else {
+				lz4.state = LZ4_TOKEN;
+			}
+			break;
+
+		case LZ4_RAW:
+			if (lz4.blk_left == 0U) {
+				lz4_block_end();
+				break;
+			}
+			n = lz4_min(lz4.blk_left, (size_t)(in_end - in));
+			n = lz4_min(n, (size_t)(out_end - out));
+			if (n == 0U) {
+				goto out;
+			}
+			memcpy(out, in, n);
+			in += n;
+			out += n;
+			lz4.blk_left -= (uint32_t)n;
+			break;
+
+		case LZ4_TOKEN:
+			ret = lz4_len_byte(&in, in_end, &byte);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			lz4.lit_len = byte >> 4;
+			lz4.match_len = byte & LZ4_RUN_MASK;
+			lz4.state = (lz4.lit_len == LZ4_RUN_MASK) ?
+				    LZ4_LIT_LEN : LZ4_LITERALS;
+			break;
+
+		case LZ4_LIT_LEN:
+			ret = lz4_len_byte(&in, in_end, &byte);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			lz4.lit_len += byte;
+			if (byte != 255U) {
+				lz4.state = LZ4_LITERALS;
+			}
+			break;
+
+		case LZ4_LITERALS:
+			if (lz4.lit_len > lz4.blk_left) {
+				ret = -EINVAL;
+				break;
+			}
+			if (lz4.lit_len == 0U) {
+				/* The last sequence of a block has no match */
+				if (lz4.blk_left == 0U) {
+					lz4_block_end();
+				} else {
+					lz4_field_start(2U, LZ4_OFFSET);
+				}
+				break;
+			}
+			n = lz4_min(lz4.lit_len, (size_t)(in_end - in));
+			n = lz4_min(n, (size_t)(out_end - out));
+			if (n == 0U) {
+				goto out;
+			}
+			memcpy(out, in, n);
+			in += n;
+			out += n;
+			lz4.lit_len -= n;
+			lz4.blk_left -= (uint32_t)n;
+			break;
+
+		case LZ4_OFFSET:
+			ret = lz4_field_read(&in, in_end, true);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			lz4.offset = lz4.field;
+			if ((lz4.offset == 0U) ||
+			    (lz4.offset > ((uintptr_t)out - lz4.out_start))) {
+				ret = -EINVAL;
+				break;
+			}
+			if (lz4.match_len == LZ4_RUN_MASK) {
+				lz4.state = LZ4_MATCH_LEN;
+			} else {
+				lz4.match_len += LZ4_MIN_MATCH;
+				lz4.state = LZ4_MATCH;
+			}
+			break;
+
+		case LZ4_MATCH_LEN:
+			ret = lz4_len_byte(&in, in_end, &byte);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			lz4.match_len += byte;
+			if (byte != 255U) {
+				lz4.match_len += LZ4_MIN_MATCH;
+				lz4.state = LZ4_MATCH;
+			}
+			break;
+
+		case LZ4_MATCH:
+			if (lz4.match_len == 0U) {
+				lz4.state = LZ4_TOKEN;
+				break;
+			}
+			n = lz4_min(lz4.match_len, (size_t)(out_end - out));
+			if (n == 0U) {
+				goto out;
+			}
+			lz4.match_len -= n;
+			if (lz4.offset >= n) {
+				memcpy(out, out - lz4.offset, n);
+				out += n;
+			} else {
+				/* Overlapping match: repeat the last bytes */
+				for (; n != 0U; n--, out++) {
+					*out = *(out - lz4.offset);
+				}
+			}
+			break;
+
+		case LZ4_BLOCK_CSUM:
+			ret = lz4_field_read(&in, in_end, false);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			lz4_field_start(4U, LZ4_BLOCK_SIZE);
+			break;
+
+		case LZ4_CONTENT_CSUM:
+			ret = lz4_field_read(&in, in_end, false);
+			if (ret <= 0) {
+				goto out;
+			}
+			ret = 0;
+			lz4.state = LZ4_DONE;
+			break;
+
+		case LZ4_DONE:
+			ret = 1;
+			break;
+
+		default:
+			ret = -EINVAL;
+			break;
+		}
+	}
+
+out:
+	*inp = in;
+	*outp = out;
+
+	return ret;
+}
+
+static int lz4_io_run(uintptr_t *in_buf, size_t *in_len,
+		      uintptr_t *out_buf, size_t *out_len)
+{
+	const uint8_t *in = (const uint8_t *)*in_buf;
+	uint8_t *out = (uint8_t *)*out_buf;
+	int ret;
+
+	if (!lz4.out_set) {
+		lz4.out_start = *out_buf;
+		lz4.out_next = *out_buf;
+		lz4.out_set = true;
+	}
+
+	/* Matches may refer to the output of the previous calls */
+	if (*out_buf != lz4.out_next) {
+		ERROR("lz4: output must be contiguous\n");
+		return -EINVAL;
+	}
+
+	ret = lz4_decode(&in, in + *in_len, &out, out + *out_len);
+	if (ret < 0) {
+		ERROR("lz4: corrupt frame (ret = %d)\n", ret);
+		return ret;
+	}
+
+	*in_len -= (size_t)(in - (const uint8_t *)*in_buf);
+	*out_len -= (size_t)(out - (uint8_t *)*out_buf);
+	*in_buf = (uintptr_t)in;
+	*out_buf = (uintptr_t)out;
+	lz4.out_next = *out_buf;
+
+	return ret;
+}
+
+const io_decompressor_t lz4_io_decompressor = {
+	.tail_len = 0U,
+	.get_size = lz4_io_get_size,
+	.start = lz4_io_start,
+	.run = lz4_io_run,
+};
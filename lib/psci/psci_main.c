@@ -10,6 +10,7 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <drivers/console.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
 #include <lib/smccc.h>
@@ -86,6 +87,9 @@ int psci_cpu_suspend(unsigned int power_state,
 		panic();
 	}
 
+	/* The CPU is about to idle, output the messages it has buffered */
+	console_log_drain();
+
 	/* Fast path for CPU standby.*/
 	if (is_cpu_standby_req(is_power_down_state, target_pwrlvl)) {
 		if  (psci_plat_pm_ops->cpu_standby == NULL)
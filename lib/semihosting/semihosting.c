@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,19 @@
 
 long semihosting_call(unsigned long operation, uintptr_t system_block_address);
 
+/*
+ * Number of semihosting calls made, each one trapping to the host. It is not
+ * updated atomically, as it is meant for profiling the boot on a single CPU.
+ */
+static unsigned long smh_trap_count;
+
+static long smh_call(unsigned long operation, uintptr_t system_block_address)
+{
+	smh_trap_count++;
+
+	return semihosting_call(operation, system_block_address);
+}
+
 typedef struct {
 	const char *file_name;
 	unsigned long mode;
@@ -43,6 +56,11 @@ long semihosting_connection_supported(void)
 	return SEMIHOSTING_SUPPORTED;
 }
 
+unsigned long semihosting_trap_count(void)
+{
+	return smh_trap_count;
+}
+
 long semihosting_file_open(const char *file_name, size_t mode)
 {
 	smh_file_open_block_t open_block;
@@ -51,7 +69,7 @@ long semihosting_file_open(const char *file_name, size_t mode)
 	open_block.mode = mode;
 	open_block.name_length = strlen(file_name);
 
-	return semihosting_call(SEMIHOSTING_SYS_OPEN, (uintptr_t)&open_block);
+	return smh_call(SEMIHOSTING_SYS_OPEN, (uintptr_t)&open_block);
 }
 
 long semihosting_file_seek(long file_handle, ssize_t offset)
@@ -62,10 +80,10 @@ long semihosting_file_seek(long file_handle, ssize_t offset)
 	seek_block.handle = file_handle;
 	seek_block.location = offset;
 
-	result = semihosting_call(SEMIHOSTING_SYS_SEEK, (uintptr_t)&seek_block);
+	result = smh_call(SEMIHOSTING_SYS_SEEK, (uintptr_t)&seek_block);
 
 	if (result < 0) {
-		result = semihosting_call(SEMIHOSTING_SYS_ERRNO, 0);
+		result = smh_call(SEMIHOSTING_SYS_ERRNO, 0);
 	} else  {
 		result = 0;
 	}
@@ -86,7 +104,7 @@ long semihosting_file_read(long file_handle, size_t *length, uintptr_t buffer)
 	read_block.buffer = buffer;
 	read_block.length = *length;
 
-	result = semihosting_call(SEMIHOSTING_SYS_READ, (uintptr_t)&read_block);
+	result = smh_call(SEMIHOSTING_SYS_READ, (uintptr_t)&read_block);
 
 	if (result == *length) {
 		return -EINVAL;
@@ -112,7 +130,7 @@ long semihosting_file_write(long file_handle, size_t *length,
 	write_block.buffer = (uintptr_t)buffer; /* cast away const */
 	write_block.length = *length;
 
-	result = semihosting_call(SEMIHOSTING_SYS_WRITE,
+	result = smh_call(SEMIHOSTING_SYS_WRITE,
 		(uintptr_t)&write_block);
 
 	*length = result;
@@ -122,27 +140,27 @@ long semihosting_file_write(long file_handle, size_t *length,
 
 long semihosting_file_close(long file_handle)
 {
-	return semihosting_call(SEMIHOSTING_SYS_CLOSE, (uintptr_t)&file_handle);
+	return smh_call(SEMIHOSTING_SYS_CLOSE, (uintptr_t)&file_handle);
 }
 
 long semihosting_file_length(long file_handle)
 {
-	return semihosting_call(SEMIHOSTING_SYS_FLEN, (uintptr_t)&file_handle);
+	return smh_call(SEMIHOSTING_SYS_FLEN, (uintptr_t)&file_handle);
 }
 
 char semihosting_read_char(void)
 {
-	return semihosting_call(SEMIHOSTING_SYS_READC, 0);
+	return smh_call(SEMIHOSTING_SYS_READC, 0);
 }
 
 void semihosting_write_char(char character)
 {
-	semihosting_call(SEMIHOSTING_SYS_WRITEC, (uintptr_t)&character);
+	smh_call(SEMIHOSTING_SYS_WRITEC, (uintptr_t)&character);
 }
 
 void semihosting_write_string(char *string)
 {
-	semihosting_call(SEMIHOSTING_SYS_WRITE0, (uintptr_t)string);
+	smh_call(SEMIHOSTING_SYS_WRITE0, (uintptr_t)string);
 }
 
 long semihosting_system(char *command_line)
@@ -152,7 +170,7 @@ long semihosting_system(char *command_line)
 	system_block.command_line = command_line;
 	system_block.command_length = strlen(command_line);
 
-	return semihosting_call(SEMIHOSTING_SYS_SYSTEM,
+	return smh_call(SEMIHOSTING_SYS_SYSTEM,
 		(uintptr_t)&system_block);
 }
 
@@ -227,9 +245,9 @@ void semihosting_exit(uint32_t reason, uint32_t subcode)
 #ifdef __aarch64__
 	uint64_t parameters[] = {reason, subcode};
 
-	(void)semihosting_call(SEMIHOSTING_SYS_EXIT, (uintptr_t)&parameters);
+	(void)smh_call(SEMIHOSTING_SYS_EXIT, (uintptr_t)&parameters);
 #else
 	/* The subcode is not supported on AArch32. */
-	(void)semihosting_call(SEMIHOSTING_SYS_EXIT, reason);
+	(void)smh_call(SEMIHOSTING_SYS_EXIT, reason);
 #endif
 }
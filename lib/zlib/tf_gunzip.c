@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,6 +10,7 @@
 
 #include <common/debug.h>
 #include <common/tf_crc32.h>
+#include <drivers/io/io_decompress.h>
 #include <lib/utils.h>
 #include <tf_gunzip.h>
 
@@ -102,6 +103,102 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	return ret;
 }
 
+/* gzip member header: ID1, ID2 and CM (deflate) */
+#define GZIP_ID1		0x1fU
+#define GZIP_ID2		0x8bU
+#define GZIP_CM_DEFLATE		8U
+
+/* Length of the ISIZE field ending a gzip member */
+#define GZIP_ISIZE_LEN		4U
+
+static z_stream gunzip_stream;
+
+/*
+ * The decompressed size is stored modulo 2^32 in the ISIZE field at the end
+ * of the member, which is enough for any image TF-A loads.
+ */
+static int gunzip_io_get_size(const uint8_t *head, size_t head_len,
+			      const uint8_t *tail, size_t *size)
+{
+	if ((head_len < 3U) || (head[0] != GZIP_ID1) ||
+	    (head[1] != GZIP_ID2) || (head[2] != GZIP_CM_DEFLATE)) {
+		return -EINVAL;
+	}
+
+	*size = (size_t)tail[0] | ((size_t)tail[1] << 8) |
+		((size_t)tail[2] << 16) | ((size_t)tail[3] << 24);
+
+	return 0;
+}
+
+static int gunzip_io_start(uintptr_t work_buf, size_t work_len)
+{
+	int zret;
+
+	zalloc_start = work_buf;
+	zalloc_end = work_buf + work_len;
+	zalloc_current = zalloc_start;
+
+	memset(&gunzip_stream, 0, sizeof(gunzip_stream));
+	gunzip_stream.zalloc = zcalloc;
+	gunzip_stream.zfree = zfree;
+	gunzip_stream.opaque = (voidpf)0;
+
+	zret = inflateInit(&gunzip_stream);
+	if (zret != Z_OK) {
+		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * Inflate as much of the input as fits in the output. zlib keeps its own
+ * 32KB window in the workspace, so the output may be split at any point.
+ */
+static int gunzip_io_run(uintptr_t *in_buf, size_t *in_len,
+			 uintptr_t *out_buf, size_t *out_len)
+{
+	z_stream *stream = &gunzip_stream;
+	int zret;
+
+	stream->next_in = (typeof(stream->next_in))*in_buf;
+	stream->avail_in = (uInt)*in_len;
+	stream->next_out = (typeof(stream->next_out))*out_buf;
+	stream->avail_out = (uInt)*out_len;
+
+	zret = inflate(stream, Z_NO_FLUSH);
+
+	*in_buf = (uintptr_t)stream->next_in;
+	*in_len = stream->avail_in;
+	*out_buf = (uintptr_t)stream->next_out;
+	*out_len = stream->avail_out;
+
+	switch (zret) {
+	case Z_STREAM_END:
+		VERBOSE("zlib: %lu byte input\n", stream->total_in);
+		VERBOSE("zlib: %lu byte output\n", stream->total_out);
+		inflateEnd(stream);
+		return 1;
+	case Z_OK:
+	case Z_BUF_ERROR:
+		return 0;
+	default:
+		if (stream->msg)
+			ERROR("%s\n", stream->msg);
+		ERROR("zlib: inflate failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+}
+
+const io_decompressor_t gunzip_io_decompressor = {
+	.tail_len = GZIP_ISIZE_LEN,
+	.get_size = gunzip_io_get_size,
+	.start = gunzip_io_start,
+	.run = gunzip_io_run,
+};
+
 /* Wrapper function to calculate CRC
  * @crc: previous accumulated CRC
  * @buf: buffer base address
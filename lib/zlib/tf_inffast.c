@@ -0,0 +1,319 @@
+/* tf_inffast.c -- fast decoding with a 64-bit bit buffer and wide copies
+ * Copyright (C) 1995-2017 Mark Adler
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ *
+ * Drop-in replacement for inffast.c, selected with ZLIB_FAST_INFLATE=1.
+ * Compared to inffast.c:
+ *
+ *  - The bit buffer is refilled once per length/distance pair, to at least
+ *    56 bits, with a single 8-byte little-endian load when there are 8 bytes
+ *    of input left, rather than 16 bits at a time before each code.
+ *
+ *  - Matches are copied 8 bytes at a time. Short distances are first
+ *    expanded bytewise until the pattern repeats at a distance of 8 or more.
+ *    When the output buffer has room for it, the last chunk of a match may
+ *    write up to 7 bytes past the match; these are overwritten by the
+ *    following codes. Nothing is ever written past the end of the output
+ *    buffer.
+ *
+ * The 8-byte accesses go through __builtin_memcpy(), so they are split into
+ * narrower accesses by the compiler when unaligned accesses are not allowed
+ * (-mstrict-align, as TF-A builds with).
+ */
+
+#include "zutil.h"
+#include "inftrees.h"
+#include "inflate.h"
+#include "inffast.h"
+
+#if !defined(__LP64__)
+#  error "tf_inffast.c needs a 64-bit unsigned long bit buffer"
+#endif
+
+#ifdef INFLATE_ALLOW_INVALID_DISTANCE_TOOFAR_ARRR
+#  error "INFLATE_ALLOW_INVALID_DISTANCE_TOOFAR_ARRR is not supported"
+#endif
+
+#define CHUNK 8U
+
+/* Load 8 bytes of input as a little-endian value */
+local inline unsigned long load64le(z_const unsigned char FAR *p) {
+    unsigned long v;
+
+    __builtin_memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/*
+   Copy len bytes from 'from' to 'out', a chunk at a time. 'from' must not
+   overlap the bytes being written, or be at least CHUNK bytes behind 'out'.
+   If 'overshoot' is set, the last chunk is copied whole, writing up to
+   CHUNK - 1 bytes past the copy and reading as many bytes past 'from'.
+ */
+local inline unsigned char FAR *chunk_copy(unsigned char FAR *out,
+                                           const unsigned char FAR *from,
+                                           unsigned len, int overshoot) {
+    unsigned char FAR *end = out + len;
+
+    if (overshoot) {
+        do {
+            __builtin_memcpy(out, from, CHUNK);
+            out += CHUNK;
+            from += CHUNK;
+        } while (out < end);
+        return end;
+    }
+    while (len >= CHUNK) {
+        __builtin_memcpy(out, from, CHUNK);
+        out += CHUNK;
+        from += CHUNK;
+        len -= CHUNK;
+    }
+    while (len--)
+        *out++ = *from++;
+    return out;
+}
+
+/*
+   Copy a match of len bytes at distance dist from the output. 'limit' is the
+   end of the output buffer.
+ */
+local inline unsigned char FAR *match_copy(unsigned char FAR *out,
+                                           unsigned dist, unsigned len,
+                                           unsigned char FAR *limit) {
+    /* multiple of dist of at least CHUNK, for dist < CHUNK */
+    static const unsigned char period[CHUNK] = {0, 8, 8, 9, 8, 10, 12, 14};
+    const unsigned char FAR *from = out - dist;
+    unsigned n;
+
+    if (dist < CHUNK) {
+        /* expand the pattern until it repeats at a distance >= CHUNK */
+        n = period[dist] - dist;
+        if (n >= len) {
+            while (len--)
+                *out++ = *from++;
+            return out;
+        }
+        len -= n;
+        while (n--)
+            *out++ = *from++;
+        from = out - period[dist];
+    }
+    return chunk_copy(out, from, len, (unsigned)(limit - out) >= len + CHUNK);
+}
+
+/*
+   Decode literal, length, and distance codes and write out the resulting
+   literal and match bytes until either not enough input or output is
+   available, an end-of-block is encountered, or a data error is encountered.
+
+   Entry assumptions and return states are the same as for inffast.c:
+
+        state->mode == LEN
+        strm->avail_in >= 6
+        strm->avail_out >= 258
+        start >= strm->avail_out
+        state->bits < 8
+
+   A length/distance pair needs at most 48 bits of input, so refilling the
+   bit buffer to 48 bits or more at the top of the loop is enough to decode
+   one whole pair without checking for input again.
+ */
+void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
+    struct inflate_state FAR *state;
+    z_const unsigned char FAR *in;      /* local strm->next_in */
+    z_const unsigned char FAR *last;    /* have enough input while in < last */
+    z_const unsigned char FAR *in_end;  /* end of the input */
+    unsigned char FAR *out;     /* local strm->next_out */
+    unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
+    unsigned char FAR *end;     /* while out < end, enough space available */
+    unsigned char FAR *limit;   /* end of the output buffer */
+#ifdef INFLATE_STRICT
+    unsigned dmax;              /* maximum distance from zlib header */
+#endif
+    unsigned wsize;             /* window size or zero if not using window */
+    unsigned whave;             /* valid bytes in the window */
+    unsigned wnext;             /* window write index */
+    unsigned char FAR *window;  /* allocated sliding window, if wsize != 0 */
+    unsigned long hold;         /* local strm->hold */
+    unsigned bits;              /* local strm->bits */
+    code const FAR *lcode;      /* local strm->lencode */
+    code const FAR *dcode;      /* local strm->distcode */
+    unsigned lmask;             /* mask for first level of length codes */
+    unsigned dmask;             /* mask for first level of distance codes */
+    code const *here;           /* retrieved table entry */
+    unsigned op;                /* code bits, operation, extra bits, or */
+                                /*  window position, window bytes to copy */
+    unsigned len;               /* match length, unused bytes */
+    unsigned dist;              /* match distance */
+    unsigned char FAR *from;    /* where to copy match from */
+
+    /* copy state to local variables */
+    state = (struct inflate_state FAR *)strm->state;
+    in = strm->next_in;
+    last = in + (strm->avail_in - 5);
+    in_end = in + strm->avail_in;
+    out = strm->next_out;
+    beg = out - (start - strm->avail_out);
+    end = out + (strm->avail_out - 257);
+    limit = out + strm->avail_out;
+#ifdef INFLATE_STRICT
+    dmax = state->dmax;
+#endif
+    wsize = state->wsize;
+    whave = state->whave;
+    wnext = state->wnext;
+    window = state->window;
+    hold = state->hold;
+    bits = state->bits;
+    lcode = state->lencode;
+    dcode = state->distcode;
+    lmask = (1U << state->lenbits) - 1;
+    dmask = (1U << state->distbits) - 1;
+
+    /* decode literals and length/distances until end-of-block or not enough
+       input data or output space */
+    do {
+        if (bits < 48) {
+            if (in_end - in >= 8) {
+                /* bits above 'bits' in hold are the next input bits, so
+                   OR-ing the same bits in again is harmless */
+                hold |= load64le(in) << bits;
+                in += (63 - bits) >> 3;
+                bits |= 56;
+            }
+            else {
+                /* in < last leaves at least 6 bytes */
+                do {
+                    hold |= (unsigned long)(*in++) << bits;
+                    bits += 8;
+                } while (bits < 48);
+            }
+        }
+        here = lcode + (hold & lmask);
+      dolen:
+        op = (unsigned)(here->bits);
+        hold >>= op;
+        bits -= op;
+        op = (unsigned)(here->op);
+        if (op == 0) {                          /* literal */
+            Tracevv((stderr, here->val >= 0x20 && here->val < 0x7f ?
+                    "inflate:         literal '%c'\n" :
+                    "inflate:         literal 0x%02x\n", here->val));
+            *out++ = (unsigned char)(here->val);
+        }
+        else if (op & 16) {                     /* length base */
+            len = (unsigned)(here->val);
+            op &= 15;                           /* number of extra bits */
+            if (op) {
+                len += (unsigned)hold & ((1U << op) - 1);
+                hold >>= op;
+                bits -= op;
+            }
+            Tracevv((stderr, "inflate:         length %u\n", len));
+            here = dcode + (hold & dmask);
+          dodist:
+            op = (unsigned)(here->bits);
+            hold >>= op;
+            bits -= op;
+            op = (unsigned)(here->op);
+            if (op & 16) {                      /* distance base */
+                dist = (unsigned)(here->val);
+                op &= 15;                       /* number of extra bits */
+                dist += (unsigned)hold & ((1U << op) - 1);
+#ifdef INFLATE_STRICT
+                if (dist > dmax) {
+                    strm->msg = (char *)"invalid distance too far back";
+                    state->mode = BAD;
+                    break;
+                }
+#endif
+                hold >>= op;
+                bits -= op;
+                Tracevv((stderr, "inflate:         distance %u\n", dist));
+                op = (unsigned)(out - beg);     /* max distance in output */
+                if (dist > op) {                /* see if copy from window */
+                    op = dist - op;             /* distance back in window */
+                    if (op > whave) {
+                        if (state->sane) {
+                            strm->msg =
+                                (char *)"invalid distance too far back";
+                            state->mode = BAD;
+                            break;
+                        }
+                    }
+                    /* window bytes are copied without reading past them */
+                    from = window;
+                    if (wnext == 0) {           /* very common case */
+                        from += wsize - op;
+                    }
+                    else if (wnext < op) {      /* wrap around window */
+                        from += wsize + wnext - op;
+                        op -= wnext;
+                        if (op < len) {         /* some from end of window */
+                            len -= op;
+                            out = chunk_copy(out, from, op, 0);
+                            from = window;
+                            op = wnext;
+                        }
+                    }
+                    else {                      /* contiguous in window */
+                        from += wnext - op;
+                    }
+                    if (op < len) {             /* rest from output */
+                        len -= op;
+                        out = chunk_copy(out, from, op, 0);
+                        out = match_copy(out, dist, len, limit);
+                    }
+                    else
+                        out = chunk_copy(out, from, len, 0);
+                }
+                else
+                    out = match_copy(out, dist, len, limit);
+            }
+            else if ((op & 64) == 0) {          /* 2nd level distance code */
+                here = dcode + here->val + (hold & ((1U << op) - 1));
+                goto dodist;
+            }
+            else {
+                strm->msg = (char *)"invalid distance code";
+                state->mode = BAD;
+                break;
+            }
+        }
+        else if ((op & 64) == 0) {              /* 2nd level length code */
+            here = lcode + here->val + (hold & ((1U << op) - 1));
+            goto dolen;
+        }
+        else if (op & 32) {                     /* end-of-block */
+            Tracevv((stderr, "inflate:         end of block\n"));
+            state->mode = TYPE;
+            break;
+        }
+        else {
+            strm->msg = (char *)"invalid literal/length code";
+            state->mode = BAD;
+            break;
+        }
+    } while (in < last && out < end);
+
+    /* return unused bytes (bits may be up to 63 here) */
+    len = bits >> 3;
+    in -= len;
+    bits -= len << 3;
+    hold &= (1UL << bits) - 1;
+
+    /* update state and return */
+    strm->next_in = in;
+    strm->next_out = out;
+    strm->avail_in = (unsigned)(in < last ? 5 + (last - in) : 5 - (in - last));
+    strm->avail_out = (unsigned)(out < end ?
+                                 257 + (end - out) : 257 - (out - end));
+    state->hold = hold;
+    state->bits = bits;
+    return;
+}
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2018, Arm Limited and Contributors. All rights reserved.
+# Copyright (c) 2018-2023, Arm Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -10,7 +10,6 @@ ZLIB_PATH	:=	lib/zlib
 ZLIB_SOURCES	:=	$(addprefix $(ZLIB_PATH)/,	\
 					adler32.c	\
 					crc32.c		\
-					inffast.c	\
 					inflate.c	\
 					inftrees.c	\
 					zutil.c)
@@ -19,6 +18,14 @@ ZLIB_SOURCES	:=	$(addprefix $(ZLIB_PATH)/,	\
 ZLIB_SOURCES	+=	$(addprefix $(ZLIB_PATH)/,	\
 					tf_gunzip.c)
 
+# inflate_fast() with a 64-bit bit buffer and wide match copies, or the
+# imported one
+ifeq (${ZLIB_FAST_INFLATE},1)
+ZLIB_SOURCES	+=	$(ZLIB_PATH)/tf_inffast.c
+else
+ZLIB_SOURCES	+=	$(ZLIB_PATH)/inffast.c
+endif
+
 INCLUDES	+=	-Iinclude/lib/zlib
 
 # REVISIT: the following flags need not be given globally
@@ -26,6 +26,12 @@ ARM_ARCH_FEATURE		:= none
 ARM_ARCH_MAJOR			:= 8
 ARM_ARCH_MINOR			:= 0
 
+# Authenticate the memory mapped images before copying them
+AUTH_IN_PLACE			:= 0
+
+# Share signature verification results between BL1 and BL2
+AUTH_SIG_CACHE			:= 0
+
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
@@ -109,6 +115,10 @@ ENCRYPT_BL31			:= 0
 # By default BL32 encryption disabled
 ENCRYPT_BL32			:= 0
 
+# Size of the independently authenticated chunks of an encrypted firmware,
+# 0 encrypts the firmware as a single chunk
+ENC_CHUNK_SIZE			:= 0
+
 # Default dummy firmware encryption key
 ENC_KEY	:= 1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef
 
@@ -228,6 +238,10 @@ SEPARATE_BL2_NOLOAD_REGION	:= 0
 # cores stack
 RECLAIM_INIT_CODE		:= 0
 
+# Cache the last CCA platform attestation token in EL3 and serve requests
+# with the same challenge from the cache
+RMMD_ATTEST_TOKEN_CACHE		:= 0
+
 # SPD choice
 SPD				:= none
 
@@ -368,8 +382,20 @@ PSA_CRYPTO			:= 0
 # should only be enabled if there is a use case for it.
 ENABLE_CONSOLE_GETC		:= 0
 
+# Buffer console output in per-CPU memory rings, output to the consoles when
+# flushed or when the CPU idles, rather than character by character.
+ENABLE_CONSOLE_LOG_BUFFER	:= 0
+
+# Log the tokens of the log macros format strings and their raw arguments to
+# a memory buffer, to be decoded on the host, instead of formatting messages.
+ENABLE_TOKENIZED_LOG		:= 0
+
 # Build option to disable EL2 when it is not used.
 # Most platforms switch from EL3 to NS-EL2 and hence the unused NS-EL2
 # functions must be enabled by platforms if they require it.
 # Disabled by default.
 INIT_UNUSED_NS_EL2		:= 0
+
+# Build option to use the inflate fast loop with a 64-bit bit buffer and wide
+# match copies when lib/zlib is used. AArch64 only. Disabled by default.
+ZLIB_FAST_INFLATE		:= 0
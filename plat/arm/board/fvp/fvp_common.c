@@ -480,6 +480,13 @@ int plat_get_mbedtls_heap(void **heap_addr, size_t *heap_size)
 }
 #endif /* CRYPTO_SUPPORT */
 
+#if AUTH_SIG_CACHE
+int plat_get_auth_sig_cache(void **cache_addr, size_t *cache_size)
+{
+	return arm_get_auth_sig_cache(cache_addr, cache_size);
+}
+#endif /* AUTH_SIG_CACHE */
+
 void fvp_timer_init(void)
 {
 #if USE_SP804_TIMER
@@ -1,11 +1,13 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 
+#include <platform_def.h>
+
 #include <common/debug.h>
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_semihosting.h>
@@ -41,6 +43,17 @@
 static const io_dev_connector_t *sh_dev_con;
 static uintptr_t sh_dev_handle;
 
+#ifdef PLAT_SEMIHOSTING_CACHE_BASE
+/* Memory in which the files read through semihosting are cached */
+static const io_sh_dev_spec_t sh_dev_spec = {
+	.cache_base = PLAT_SEMIHOSTING_CACHE_BASE,
+	.cache_size = PLAT_SEMIHOSTING_CACHE_SIZE,
+};
+#define SH_DEV_SPEC			((uintptr_t)&sh_dev_spec)
+#else
+#define SH_DEV_SPEC			((uintptr_t)NULL)
+#endif
+
 static const io_file_spec_t sh_file_spec[] = {
 	[BL2_IMAGE_ID] = {
 		.path = BL2_IMAGE_NAME,
@@ -152,7 +165,7 @@ void plat_arm_io_setup(void)
 	}
 
 	/* Open connections to devices and cache the handles */
-	io_result = io_dev_open(sh_dev_con, (uintptr_t)NULL, &sh_dev_handle);
+	io_result = io_dev_open(sh_dev_con, SH_DEV_SPEC, &sh_dev_handle);
 	if (io_result < 0) {
 		panic();
 	}
@@ -202,6 +202,11 @@ void arm_bl1_platform_setup(void)
 	arm_bl1_set_mbedtls_heap();
 #endif /* CRYPTO_SUPPORT */
 
+#if AUTH_SIG_CACHE
+	/* Share the signature verification results with BL2 */
+	arm_bl1_set_auth_sig_cache();
+#endif /* AUTH_SIG_CACHE */
+
 	/*
 	 * Allow access to the System counter timer module and program
 	 * counter frequency for non secure images during FWU
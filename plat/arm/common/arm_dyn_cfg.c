@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <common/desc_image_load.h>
 #include <common/tbbr/tbbr_img_def.h>
+#include <drivers/auth/auth_mod.h>
 #include <lib/fconf/fconf.h>
 #include <lib/fconf/fconf_dyn_cfg_getter.h>
 #include <lib/fconf/fconf_tbbr_getter.h>
@@ -120,6 +121,74 @@ void arm_bl1_set_mbedtls_heap(void)
 }
 #endif /* CRYPTO_SUPPORT */
 
+#if AUTH_SIG_CACHE
+
+#ifndef ARM_AUTH_SIG_CACHE_ENTRIES
+#define ARM_AUTH_SIG_CACHE_ENTRIES	8U
+#endif
+
+static void *auth_sig_cache_addr;
+static size_t auth_sig_cache_size;
+
+/*
+ * The signature verification cache lives in BL1 RW data, like the shared
+ * Mbed TLS heap, and its location is passed to BL2 through TB_FW_CONFIG.
+ */
+int arm_get_auth_sig_cache(void **cache_addr, size_t *cache_size)
+{
+	assert(cache_addr != NULL);
+	assert(cache_size != NULL);
+
+#if defined(IMAGE_BL1) || RESET_TO_BL2
+	static uint64_t cache[AUTH_SIG_CACHE_SIZE(ARM_AUTH_SIG_CACHE_ENTRIES) /
+			      sizeof(uint64_t)];
+
+	*cache_addr = cache;
+	*cache_size = sizeof(cache);
+	auth_sig_cache_addr = cache;
+	auth_sig_cache_size = sizeof(cache);
+#elif defined(IMAGE_BL2)
+	*cache_addr = FCONF_GET_PROPERTY(tbbr, dyn_config, auth_sig_cache_addr);
+	*cache_size = FCONF_GET_PROPERTY(tbbr, dyn_config, auth_sig_cache_size);
+#else
+	*cache_addr = NULL;
+	*cache_size = 0U;
+#endif
+
+	return 0;
+}
+
+/*
+ * Puts the signature cache information to the DTB.
+ * Executed only from BL1.
+ */
+void arm_bl1_set_auth_sig_cache(void)
+{
+	uintptr_t tb_fw_cfg_dtb;
+	const struct dyn_cfg_dtb_info_t *tb_fw_config_info;
+
+	tb_fw_config_info = FCONF_GET_PROPERTY(dyn_cfg, dtb, TB_FW_CONFIG_ID);
+	assert(tb_fw_config_info != NULL);
+
+	tb_fw_cfg_dtb = tb_fw_config_info->config_addr;
+
+	if ((tb_fw_cfg_dtb != 0UL) && (auth_sig_cache_addr != NULL)) {
+		/* As libfdt uses void *, we can't avoid this cast */
+		void *dtb = (void *)tb_fw_cfg_dtb;
+
+		/* BL2 falls back to verifying all signatures on failure */
+		if (arm_set_dtb_auth_sig_cache_info(dtb, auth_sig_cache_addr,
+						    auth_sig_cache_size) < 0) {
+			WARN("BL1: unable to share the signature cache\n");
+			return;
+		}
+#if !MEASURED_BOOT
+		flush_dcache_range(tb_fw_cfg_dtb, fdt_totalsize(dtb));
+#endif /* !MEASURED_BOOT */
+	}
+}
+#endif /* AUTH_SIG_CACHE */
+
 /*
  * BL2 utility function to initialize dynamic configuration specified by
  * FW_CONFIG. Populate the bl_mem_params_node_t of other FW_CONFIGs if
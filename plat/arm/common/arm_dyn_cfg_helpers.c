@@ -21,6 +21,8 @@
 
 #define DTB_PROP_MBEDTLS_HEAP_ADDR "mbedtls_heap_addr"
 #define DTB_PROP_MBEDTLS_HEAP_SIZE "mbedtls_heap_size"
+#define DTB_PROP_AUTH_SIG_CACHE_ADDR "auth_sig_cache_addr"
+#define DTB_PROP_AUTH_SIG_CACHE_SIZE "auth_sig_cache_size"
 
 #if MEASURED_BOOT
 #ifdef SPD_opteed
@@ -123,6 +125,48 @@ int arm_set_dtb_mbedtls_heap_info(void *dtb, void *heap_addr, size_t heap_size)
 	return 0;
 }
 
+#if AUTH_SIG_CACHE
+/*
+ * Write the address and size of the signature cache shared by BL1 in the DTB.
+ * This function is supposed to be called only by BL1.
+ *
+ * Returns:
+ *	0 = success
+ *     -1 = error
+ */
+int arm_set_dtb_auth_sig_cache_info(void *dtb, void *cache_addr,
+				    size_t cache_size)
+{
+	int dtb_root;
+	int err;
+
+	err = arm_dyn_tb_fw_cfg_init(dtb, &dtb_root);
+	if (err < 0) {
+		ERROR("Invalid%s loaded. Unable to get root node\n",
+			" TB_FW_CONFIG");
+		return -1;
+	}
+
+	err = fdtw_write_inplace_cells(dtb, dtb_root,
+		DTB_PROP_AUTH_SIG_CACHE_ADDR, 2, &cache_addr);
+	if (err < 0) {
+		ERROR("%sDTB property '%s'\n",
+			"Unable to write ", DTB_PROP_AUTH_SIG_CACHE_ADDR);
+		return -1;
+	}
+
+	err = fdtw_write_inplace_cells(dtb, dtb_root,
+		DTB_PROP_AUTH_SIG_CACHE_SIZE, 1, &cache_size);
+	if (err < 0) {
+		ERROR("%sDTB property '%s'\n",
+			"Unable to write ", DTB_PROP_AUTH_SIG_CACHE_SIZE);
+		return -1;
+	}
+
+	return 0;
+}
+#endif /* AUTH_SIG_CACHE */
+
 #if MEASURED_BOOT
 /*
  * Write the Event Log address and its size in the DTB.
@@ -6,11 +6,13 @@
 
 #include <errno.h>
 
+#include <drivers/console.h>
 #include <plat/arm/common/plat_arm.h>
 #include <plat/common/platform.h>
 
 void __dead2 plat_error_handler(int err)
 {
+	console_log_drain();
 	plat_arm_error_handler(err);
 }
 
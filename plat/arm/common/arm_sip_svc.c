@@ -13,6 +13,7 @@
 #include <lib/pmf/pmf.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
+#include <services/spmd_svc.h>
 #include <tools_share/uuid.h>
 
 /* ARM SiP Service UUID */
@@ -90,6 +91,15 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 
 #endif /* ETHOSN_NPU_DRIVER */
 
+#if defined(SPD_spmd) && SPMC_AT_EL3
+
+	if (is_spmd_sip_fid(smc_fid)) {
+		return spmd_sip_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					    handle, flags);
+	}
+
+#endif /* defined(SPD_spmd) && SPMC_AT_EL3 */
+
 	switch (smc_fid) {
 	case ARM_SIP_SVC_EXE_STATE_SWITCH: {
 		/* Execution state can be switched only if EL3 is AArch64 */
@@ -122,6 +132,11 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		/* State switch call */
 		call_count += 1;
 
+#if defined(SPD_spmd) && SPMC_AT_EL3
+		/* Batched memory reclaim call */
+		call_count += 1;
+#endif
+
 		SMC_RET1(handle, call_count);
 
 	case ARM_SIP_SVC_UID:
@@ -9,6 +9,7 @@
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <drivers/console.h>
 #include <lib/xlat_tables/xlat_tables_compat.h>
 #include <plat/common/platform.h>
 #include <services/arm_arch_svc.h>
@@ -51,6 +52,8 @@ void bl2_el3_plat_prepare_exit(void)
 
 void __dead2 plat_error_handler(int err)
 {
+	console_log_drain();
+
 	while (1)
 		wfi();
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -54,6 +54,17 @@ static const io_dev_connector_t *memmap_dev_con;
 static uintptr_t memmap_dev_handle;
 static const io_dev_connector_t *sh_dev_con;
 static uintptr_t sh_dev_handle;
+
+#ifdef PLAT_SEMIHOSTING_CACHE_BASE
+/* Memory in which the files read through semihosting are cached */
+static const io_sh_dev_spec_t sh_dev_spec = {
+	.cache_base = PLAT_SEMIHOSTING_CACHE_BASE,
+	.cache_size = PLAT_SEMIHOSTING_CACHE_SIZE,
+};
+#define SH_DEV_SPEC			((uintptr_t)&sh_dev_spec)
+#else
+#define SH_DEV_SPEC			((uintptr_t)NULL)
+#endif
 #ifndef DECRYPTION_SUPPORT_none
 static const io_dev_connector_t *enc_dev_con;
 static uintptr_t enc_dev_handle;
@@ -509,7 +520,7 @@ void plat_qemu_io_setup(void)
 	assert(io_result == 0);
 
 	/* Open connections to devices and cache the handles */
-	io_result = io_dev_open(sh_dev_con, (uintptr_t)NULL, &sh_dev_handle);
+	io_result = io_dev_open(sh_dev_con, SH_DEV_SPEC, &sh_dev_handle);
 	assert(io_result == 0);
 
 	/* Ignore improbable errors in release builds */
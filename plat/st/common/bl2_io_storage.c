@@ -79,6 +79,7 @@ static io_mtd_dev_spec_t spi_nor_dev_spec = {
 	.ops = {
 		.init = spi_nor_init,
 		.read = spi_nor_read,
+		.map = spi_nor_map,
 	},
 };
 #endif
@@ -14,6 +14,7 @@
 #include <common/desc_image_load.h>
 #include <drivers/generic_delay_timer.h>
 #include <drivers/mmc.h>
+#include <drivers/spi_nor.h>
 #include <drivers/st/bsec.h>
 #include <drivers/st/regulator_fixed.h>
 #include <drivers/st/stm32_iwdg.h>
@@ -550,5 +551,12 @@ void bl2_el3_plat_prepare_exit(void)
 	}
 #endif /* STM32MP_UART_PROGRAMMER || STM32MP_USB_PROGRAMMER */
 
+#if STM32MP_SPI_NOR
+	/* The bank register is kept across reads, reset it for the next stage */
+	if (spi_nor_clean_bar() != 0) {
+		WARN("Failed to reset the NOR bank register\n");
+	}
+#endif /* STM32MP_SPI_NOR */
+
 	stm32mp1_security_setup();
 }
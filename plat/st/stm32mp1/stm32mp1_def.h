@@ -159,7 +159,11 @@ enum ddr_type {
 
 /* BL2 and BL32/sp_min require finer granularity tables */
 #if defined(IMAGE_BL2)
-#define MAX_XLAT_TABLES			U(2) /* 8 KB for mapping */
+ #if STM32MP1_MAP_QSPI_MM
+  #define MAX_XLAT_TABLES		U(3) /* 12 KB for mapping */
+ #else
+  #define MAX_XLAT_TABLES		U(2) /* 8 KB for mapping */
+ #endif
 #endif
 
 #if defined(IMAGE_BL32)
@@ -172,9 +176,9 @@ enum ddr_type {
  */
 #if defined(IMAGE_BL2)
  #if STM32MP_USB_PROGRAMMER
-  #define MAX_MMAP_REGIONS		8
+  #define MAX_MMAP_REGIONS		(8 + STM32MP1_MAP_QSPI_MM)
  #else
-  #define MAX_MMAP_REGIONS		7
+  #define MAX_MMAP_REGIONS		(7 + STM32MP1_MAP_QSPI_MM)
  #endif
 #endif
 
@@ -205,6 +209,18 @@ enum ddr_type {
 #define STM32MP1_DEVICE2_BASE		U(0x80000000)
 #define STM32MP1_DEVICE2_SIZE		U(0x40000000)
 
+/* QSPI memory-mapped window, inside the device1 area */
+#define STM32MP1_QSPI_MM_BASE		U(0x70000000)
+#define STM32MP1_QSPI_MM_SIZE		U(0x10000000)
+
+/* BL2 reads the QSPI window as Normal memory to authenticate in place */
+#if defined(IMAGE_BL2) && STM32MP_SPI_NOR && TRUSTED_BOARD_BOOT && \
+	AUTH_IN_PLACE
+#define STM32MP1_MAP_QSPI_MM		1
+#else
+#define STM32MP1_MAP_QSPI_MM		0
+#endif
+
 /*******************************************************************************
  * STM32MP1 RCC
  ******************************************************************************/
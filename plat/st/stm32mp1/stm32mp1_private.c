@@ -81,6 +81,15 @@
 					MT_SECURE | \
 					MT_EXECUTE_NEVER)
 
+#if STM32MP1_MAP_QSPI_MM
+#define MAP_QSPI_MM	MAP_REGION_FLAT(STM32MP1_QSPI_MM_BASE, \
+					STM32MP1_QSPI_MM_SIZE, \
+					MT_NON_CACHEABLE | \
+					MT_RO | \
+					MT_SECURE | \
+					MT_EXECUTE_NEVER)
+#endif
+
 #if defined(IMAGE_BL2)
 static const mmap_region_t stm32mp1_mmap[] = {
 	MAP_SEC_SYSRAM,
@@ -88,6 +97,9 @@ static const mmap_region_t stm32mp1_mmap[] = {
 	MAP_SRAM_ALL,
 #endif
 	MAP_DEVICE1,
+#if STM32MP1_MAP_QSPI_MM
+	MAP_QSPI_MM,
+#endif
 #if STM32MP_RAW_NAND
 	MAP_DEVICE2,
 #endif
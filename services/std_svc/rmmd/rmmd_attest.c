@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -13,8 +14,57 @@
 #include "rmmd_private.h"
 #include <services/rmmd_svc.h>
 
+/*
+ * Platform token and Realm attestation key requests both stage their data in
+ * the single EL3-RMM shared buffer, so they are serialised with one lock.
+ */
 static spinlock_t lock;
 
+#if RMMD_ATTEST_TOKEN_CACHE
+/*
+ * Copy of the last platform token obtained from the platform along with the
+ * challenge it was requested with. The token is bounded by the EL3-RMM shared
+ * buffer, which lies within a single page.
+ */
+static struct {
+	uint8_t challenge[SHA512_DIGEST_SIZE];
+	uint64_t c_size;
+	uint64_t token_size;
+	uint8_t token[PAGE_SIZE];
+} token_cache;
+
+static bool token_cache_lookup(uint64_t buf_pa, uint64_t *buf_size,
+			       const uint8_t *challenge, uint64_t c_size)
+{
+	if ((token_cache.token_size == 0UL) ||
+	    (token_cache.c_size != c_size) ||
+	    (token_cache.token_size > *buf_size) ||
+	    (memcmp(token_cache.challenge, challenge, c_size) != 0)) {
+		return false;
+	}
+
+	(void)memcpy((void *)buf_pa, token_cache.token,
+		     token_cache.token_size);
+	*buf_size = token_cache.token_size;
+
+	return true;
+}
+
+static void token_cache_update(uint64_t buf_pa, uint64_t token_size,
+			       const uint8_t *challenge, uint64_t c_size)
+{
+	if (token_size > sizeof(token_cache.token)) {
+		token_cache.token_size = 0UL;
+		return;
+	}
+
+	(void)memcpy(token_cache.challenge, challenge, c_size);
+	(void)memcpy(token_cache.token, (void *)buf_pa, token_size);
+	token_cache.c_size = c_size;
+	token_cache.token_size = token_size;
+}
+#endif /* RMMD_ATTEST_TOKEN_CACHE */
+
 /* For printing Realm attestation token hash */
 #define DIGITS_PER_BYTE				2UL
 #define LENGTH_OF_TERMINATING_ZERO_IN_BYTES	1UL
@@ -108,6 +158,13 @@ int rmmd_attest_get_platform_token(uint64_t buf_pa, uint64_t *buf_size,
 
 	print_challenge((uint8_t *)temp_buf, c_size);
 
+#if RMMD_ATTEST_TOKEN_CACHE
+	if (token_cache_lookup(buf_pa, buf_size, temp_buf, c_size)) {
+		spin_unlock(&lock);
+		return 0;
+	}
+#endif
+
 	/* Get the platform token. */
 	err = plat_rmmd_get_cca_attest_token((uintptr_t)buf_pa,
 		buf_size, (uintptr_t)temp_buf, c_size);
@@ -117,6 +174,12 @@ int rmmd_attest_get_platform_token(uint64_t buf_pa, uint64_t *buf_size,
 		err = E_RMM_UNK;
 	}
 
+#if RMMD_ATTEST_TOKEN_CACHE
+	if (err == 0) {
+		token_cache_update(buf_pa, *buf_size, temp_buf, c_size);
+	}
+#endif
+
 	spin_unlock(&lock);
 
 	return err;
@@ -2051,6 +2051,11 @@ uint64_t spmc_smc_handler(uint32_t smc_fid,
 		return spmc_ffa_mem_reclaim(smc_fid, secure_origin, x1, x2, x3,
 					    x4, cookie, handle, flags);
 
+	case SPMD_SIP_MEM_RECLAIM_BATCH:
+		return spmc_ffa_mem_reclaim_batch(smc_fid, secure_origin, x1,
+						  x2, x3, x4, cookie, handle,
+						  flags);
+
 	default:
 		WARN("Unsupported FF-A call 0x%08x.\n", smc_fid);
 		break;
@@ -41,6 +41,12 @@ struct spmc_shmem_obj {
  * initialization.
  */
 
+/*
+ * Handle value used to mark objects released by a batched reclaim until the
+ * datastore is compacted. It is never handed out by spmc_ffa_mem_send.
+ */
+#define SPMC_SHMEM_HANDLE_RECLAIMED	UINT64_MAX
+
 struct spmc_shmem_obj_state spmc_shmem_obj_state = {
 	/* Set start value for handle so top 32 bits are needed quickly. */
 	.next_handle = 0xffffffc0U,
@@ -161,6 +167,36 @@ spmc_shmem_obj_lookup(struct spmc_shmem_obj_state *state, uint64_t handle)
 	return NULL;
 }
 
+/**
+ * spmc_shmem_obj_compact - Free all objects marked as reclaimed.
+ * @state:      Global state.
+ *
+ * Remove every object whose handle is %SPMC_SHMEM_HANDLE_RECLAIMED in a single
+ * pass over @state->data, so releasing several objects only moves each
+ * remaining object once. As with spmc_shmem_obj_free, all pointers to struct
+ * spmc_shmem_obj objects should be considered invalid on return.
+ */
+static void spmc_shmem_obj_compact(struct spmc_shmem_obj_state *state)
+{
+	uint8_t *src = state->data;
+	uint8_t *dest = state->data;
+	uint8_t *end = state->data + state->allocated;
+
+	while (src < end) {
+		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)src;
+		size_t obj_size = spmc_shmem_obj_size(obj->desc_size);
+
+		if (obj->desc.handle != SPMC_SHMEM_HANDLE_RECLAIMED) {
+			if (dest != src) {
+				memmove(dest, src, obj_size);
+			}
+			dest += obj_size;
+		}
+		src += obj_size;
+	}
+	state->allocated = dest - state->data;
+}
+
 /**
  * spmc_shmem_obj_get_next - Get the next memory object from an offset.
  * @offset:     Offset used to track which objects have previously been
@@ -1859,6 +1895,32 @@ err_unlock_mailbox:
 	return spmc_ffa_error_return(handle, ret);
 }
 
+/**
+ * spmc_shmem_obj_reclaim - Validate and release an object to its owner.
+ * @obj:            Object to reclaim.
+ *
+ * Checks that no borrower still has @obj retrieved and that its descriptor is
+ * complete, then lets the platform perform its reclaim operations. The caller
+ * must hold spmc_shmem_obj_state.lock and is responsible for freeing @obj.
+ *
+ * Return: 0 on success, FF-A error code on failure.
+ */
+static int spmc_shmem_obj_reclaim(struct spmc_shmem_obj *obj)
+{
+	if (obj->in_use != 0U) {
+		return FFA_ERROR_DENIED;
+	}
+
+	if (obj->desc_filled != obj->desc_size) {
+		WARN("%s: incomplete object desc filled %zu < size %zu\n",
+		     __func__, obj->desc_filled, obj->desc_size);
+		return FFA_ERROR_INVALID_PARAMETER;
+	}
+
+	/* Allow for platform specific operations to be performed. */
+	return plat_spmc_shmem_reclaim(&obj->desc);
+}
+
 /**
  * spmc_ffa_mem_reclaim - FFA_MEM_RECLAIM implementation.
  * @client:         Client state.
@@ -1905,20 +1967,8 @@ int spmc_ffa_mem_reclaim(uint32_t smc_fid,
 		ret = FFA_ERROR_INVALID_PARAMETER;
 		goto err_unlock;
 	}
-	if (obj->in_use != 0U) {
-		ret = FFA_ERROR_DENIED;
-		goto err_unlock;
-	}
-
-	if (obj->desc_filled != obj->desc_size) {
-		WARN("%s: incomplete object desc filled %zu < size %zu\n",
-		     __func__, obj->desc_filled, obj->desc_size);
-		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock;
-	}
 
-	/* Allow for platform specific operations to be performed. */
-	ret = plat_spmc_shmem_reclaim(&obj->desc);
+	ret = spmc_shmem_obj_reclaim(obj);
 	if (ret != 0) {
 		goto err_unlock;
 	}
@@ -1932,3 +1982,110 @@ err_unlock:
 	spin_unlock(&spmc_shmem_obj_state.lock);
 	return spmc_ffa_error_return(handle, ret);
 }
+
+/**
+ * spmc_ffa_mem_reclaim_batch - SPMD_SIP_MEM_RECLAIM_BATCH implementation.
+ * @handle_count:   Number of 64-bit handles in the caller's transmit buffer.
+ * @mem_flags:      Unsupported, must be 0.
+ *
+ * Implementation defined extension of FFA_MEM_RECLAIM allowing the normal
+ * world to reclaim several shared memory objects in a single call, e.g. when
+ * tearing down a VM or unloading a driver. The handles are read from the
+ * caller's transmit buffer and reclaimed in order. Released objects are only
+ * marked during the walk and the datastore is compacted once at the end.
+ *
+ * On success FFA_SUCCESS is returned with w2 holding the number of reclaimed
+ * handles. If a handle cannot be reclaimed, processing stops and FFA_ERROR is
+ * returned with w3 holding the number of handles reclaimed before it.
+ *
+ * Return: 0 on success, error code on failure.
+ */
+long spmc_ffa_mem_reclaim_batch(uint32_t smc_fid,
+				bool secure_origin,
+				uint32_t handle_count,
+				uint32_t mem_flags,
+				uint64_t x3,
+				uint64_t x4,
+				void *cookie,
+				void *handle,
+				uint64_t flags)
+{
+	int ret = 0;
+	uint32_t i;
+	struct mailbox *mbox = spmc_get_mbox_desc(secure_origin);
+	const uint64_t *req;
+
+	if (secure_origin) {
+		WARN("%s: unsupported reclaim direction.\n", __func__);
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_NOT_SUPPORTED);
+	}
+
+	if (mem_flags != 0U) {
+		WARN("%s: unsupported flags 0x%x\n", __func__, mem_flags);
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_INVALID_PARAMETER);
+	}
+
+	spin_lock(&mbox->lock);
+
+	if (mbox->rxtx_page_count == 0U) {
+		WARN("%s: buffer pair not registered.\n", __func__);
+		ret = FFA_ERROR_INVALID_PARAMETER;
+		goto err_unlock_mailbox;
+	}
+
+	if ((handle_count == 0U) ||
+	    ((size_t)handle_count * sizeof(*req) >
+	     (size_t)mbox->rxtx_page_count * FFA_PAGE_SIZE)) {
+		WARN("%s: invalid handle count %u\n", __func__, handle_count);
+		ret = FFA_ERROR_INVALID_PARAMETER;
+		goto err_unlock_mailbox;
+	}
+
+	req = mbox->tx_buffer;
+
+	spin_lock(&spmc_shmem_obj_state.lock);
+
+	for (i = 0U; i < handle_count; i++) {
+		uint64_t mem_handle = req[i];
+		struct spmc_shmem_obj *obj;
+
+		if (mem_handle == SPMC_SHMEM_HANDLE_RECLAIMED) {
+			ret = FFA_ERROR_INVALID_PARAMETER;
+			break;
+		}
+
+		obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
+		if (obj == NULL) {
+			ret = FFA_ERROR_INVALID_PARAMETER;
+			break;
+		}
+
+		ret = spmc_shmem_obj_reclaim(obj);
+		if (ret != 0) {
+			break;
+		}
+
+		obj->desc.handle = SPMC_SHMEM_HANDLE_RECLAIMED;
+	}
+
+	if (i != 0U) {
+		spmc_shmem_obj_compact(&spmc_shmem_obj_state);
+	}
+
+	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(&mbox->lock);
+
+	if (ret != 0) {
+		SMC_RET8(handle, FFA_ERROR, FFA_TARGET_INFO_MBZ, ret, i,
+			 FFA_PARAM_MBZ, FFA_PARAM_MBZ, FFA_PARAM_MBZ,
+			 FFA_PARAM_MBZ);
+	}
+
+	SMC_RET3(handle, FFA_SUCCESS_SMC32, FFA_TARGET_INFO_MBZ, i);
+
+err_unlock_mailbox:
+	spin_unlock(&mbox->lock);
+	return spmc_ffa_error_return(handle, ret);
+}
@@ -112,4 +112,14 @@ int spmc_ffa_mem_reclaim(uint32_t smc_fid,
 			 void *handle,
 			 uint64_t flags);
 
+long spmc_ffa_mem_reclaim_batch(uint32_t smc_fid,
+				bool secure_origin,
+				uint32_t handle_count,
+				uint32_t mem_flags,
+				uint64_t x3,
+				uint64_t x4,
+				void *cookie,
+				void *handle,
+				uint64_t flags);
+
 #endif /* SPMC_SHARED_MEM_H */
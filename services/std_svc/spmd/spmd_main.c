@@ -828,6 +828,28 @@ uint64_t spmd_ffa_smc_handler(uint32_t smc_fid,
 				handle, flags);
 }
 
+/*******************************************************************************
+ * This function handles the SiP SMCs of the SPM dispatcher, which are serviced
+ * by the SPMC at EL3 on behalf of the normal world.
+ ******************************************************************************/
+uint64_t spmd_sip_smc_handler(uint32_t smc_fid,
+			      uint64_t x1,
+			      uint64_t x2,
+			      uint64_t x3,
+			      uint64_t x4,
+			      void *cookie,
+			      void *handle,
+			      uint64_t flags)
+{
+	if (!is_spmd_sip_fid(smc_fid) || is_caller_secure(flags) ||
+	    !is_spmc_at_el3()) {
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	return spmc_smc_handler(smc_fid, false, x1, x2, x3, x4, cookie,
+				handle, flags);
+}
+
 /*******************************************************************************
  * This function handles all SMCs in the range reserved for FFA. Each call is
  * either forwarded to the other security state or handled by the SPM dispatcher
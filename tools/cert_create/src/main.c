@@ -1,16 +1,21 @@
 /*
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <assert.h>
 #include <ctype.h>
 #include <getopt.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <sys/stat.h>
+#include <time.h>
 
 #include <openssl/conf.h>
 #include <openssl/engine.h>
@@ -65,22 +70,66 @@ static int key_size;
 static int new_keys;
 static int save_keys;
 static int print_cert;
+static int num_jobs = 1;
+static const char *batch_fn;
+
+/* Image hash algorithm and digest of each hash extension argument */
+static const EVP_MD *md_info;
+static unsigned int md_len;
+static unsigned char (*ext_md)[SHA512_DIGEST_LENGTH];
+
+/*
+ * Digests of the image files hashed so far. A file is identified by its
+ * attributes, so that an image shared by several certificate sets is only
+ * hashed once in batch mode.
+ */
+typedef struct hash_cache_entry_s {
+	dev_t dev;
+	ino_t ino;
+	off_t size;
+	time_t mtime;
+	unsigned char md[SHA512_DIGEST_LENGTH];
+} hash_cache_entry_t;
+
+static hash_cache_entry_t *hash_cache;
+static int hash_cache_len;
+static int num_hash_reused;
+
+/* Time spent in each stage, reported in batch mode */
+enum {
+	STAGE_KEYS,
+	STAGE_HASH,
+	STAGE_SIGN,
+	STAGE_WRITE,
+	NUM_STAGES
+};
+
+static const char *stage_str[NUM_STAGES] = {
+	[STAGE_KEYS] = "Load keys",
+	[STAGE_HASH] = "Hash images",
+	[STAGE_SIGN] = "Create certificates",
+	[STAGE_WRITE] = "Write certificates",
+};
+
+static double stage_ms[NUM_STAGES];
+static struct timespec stage_start;
+
+/* Work shared between the threads started by run_jobs() */
+static struct {
+	pthread_mutex_t lock;
+	void (*fn)(int);
+	const int *items;
+	int num_items;
+	int next;
+} job_queue = {
+	.lock = PTHREAD_MUTEX_INITIALIZER
+};
 
 /* Info messages created in the Makefile */
 extern const char build_msg[];
 extern const char platform_msg[];
 
 
-static char *strdup(const char *str)
-{
-	int n = strlen(str) + 1;
-	char *dup = malloc(n);
-	if (dup) {
-		strcpy(dup, str);
-	}
-	return dup;
-}
-
 static const char *key_algs_str[] = {
 	[KEY_ALG_RSA] = "rsa",
 #ifndef OPENSSL_NO_EC
@@ -291,25 +340,475 @@ static const cmd_opt_t common_cmd_opt[] = {
 	{
 		{ "print-cert", no_argument, NULL, 'p' },
 		"Print the certificates in the standard output"
+	},
+	{
+		{ "jobs", required_argument, NULL, 'j' },
+		"Number of threads used to hash the images and create the " \
+		"certificates (default: 1)"
+	},
+	{
+		{ "batch", required_argument, NULL, 'm' },
+		"Create the certificate sets listed in the given manifest file, " \
+		"one set of certificate and image options per line"
 	}
 };
 
-int main(int argc, char *argv[])
+static void stage_begin(void)
+{
+	clock_gettime(CLOCK_MONOTONIC, &stage_start);
+}
+
+static void stage_end(int stage)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	stage_ms[stage] += (now.tv_sec - stage_start.tv_sec) * 1000.0 +
+			   (now.tv_nsec - stage_start.tv_nsec) / 1000000.0;
+}
+
+static void *job_worker(void *arg)
+{
+	int item;
+
+	while (1) {
+		pthread_mutex_lock(&job_queue.lock);
+		item = job_queue.next++;
+		pthread_mutex_unlock(&job_queue.lock);
+
+		if (item >= job_queue.num_items) {
+			break;
+		}
+		job_queue.fn(job_queue.items[item]);
+	}
+
+	return NULL;
+}
+
+/*
+ * Call 'fn' for each of the 'num_items' items, spreading the calls over up
+ * to 'num_jobs' threads. Returns when all the calls have completed.
+ */
+static void run_jobs(void (*fn)(int), const int *items, int num_items)
+{
+	pthread_t *threads;
+	int i, num_threads;
+
+	num_threads = (num_jobs < num_items) ? num_jobs : num_items;
+	if (num_threads <= 1) {
+		for (i = 0 ; i < num_items ; i++) {
+			fn(items[i]);
+		}
+		return;
+	}
+
+	job_queue.fn = fn;
+	job_queue.items = items;
+	job_queue.num_items = num_items;
+	job_queue.next = 0;
+
+	CHECK_NULL(threads, malloc(num_threads * sizeof(*threads)));
+	for (i = 0 ; i < num_threads ; i++) {
+		if (pthread_create(&threads[i], NULL, job_worker, NULL) != 0) {
+			ERROR("Cannot create thread\n");
+			exit(1);
+		}
+	}
+	for (i = 0 ; i < num_threads ; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+}
+
+static void hash_image(int ext_idx)
+{
+	ext_t *ext = &extensions[ext_idx];
+
+	if (!sha_file(hash_alg, ext->arg, ext_md[ext_idx])) {
+		ERROR("Cannot calculate hash of %s\n", ext->arg);
+		exit(1);
+	}
+}
+
+/*
+ * Calculate the hash of every image referenced by the requested certificates.
+ * Each file is hashed once, even when several extensions or certificate sets
+ * refer to it.
+ */
+static void hash_images(void)
+{
+	struct stat st;
+	hash_cache_entry_t *entry;
+	int *items, *src;
+	int num_items = 0;
+	int i, j, k;
+	ext_t *ext;
+
+	if (ext_md == NULL) {
+		CHECK_NULL(ext_md, calloc(num_extensions, sizeof(*ext_md)));
+	}
+	CHECK_NULL(items, malloc(num_extensions * sizeof(*items)));
+	CHECK_NULL(src, malloc(num_extensions * sizeof(*src)));
+
+	for (i = 0 ; i < num_extensions ; i++) {
+		src[i] = -1;
+	}
+
+	for (i = 0 ; i < num_certs ; i++) {
+		if (certs[i].fn == NULL) {
+			continue;
+		}
+		for (j = 0 ; j < certs[i].num_ext ; j++) {
+			int idx = certs[i].ext[j];
+
+			ext = &extensions[idx];
+			if ((ext->type != EXT_TYPE_HASH) ||
+			    (ext->arg == NULL) || (src[idx] != -1)) {
+				continue;
+			}
+
+			if (stat(ext->arg, &st) != 0) {
+				ERROR("Cannot open file %s\n", ext->arg);
+				exit(1);
+			}
+
+			/* Reuse the hash of the same file, if any */
+			for (k = 0 ; k < hash_cache_len ; k++) {
+				entry = &hash_cache[k];
+				if ((entry->dev == st.st_dev) &&
+				    (entry->ino == st.st_ino) &&
+				    (entry->size == st.st_size) &&
+				    (entry->mtime == st.st_mtime)) {
+					break;
+				}
+			}
+			if (k == hash_cache_len) {
+				CHECK_NULL(hash_cache, realloc(hash_cache,
+					(hash_cache_len + 1) * sizeof(*entry)));
+				entry = &hash_cache[hash_cache_len++];
+				entry->dev = st.st_dev;
+				entry->ino = st.st_ino;
+				entry->size = st.st_size;
+				entry->mtime = st.st_mtime;
+				items[num_items++] = idx;
+			} else {
+				num_hash_reused++;
+			}
+			src[idx] = k;
+		}
+	}
+
+	run_jobs(hash_image, items, num_items);
+
+	for (i = 0 ; i < num_items ; i++) {
+		memcpy(hash_cache[src[items[i]]].md, ext_md[items[i]],
+		       sizeof(ext_md[0]));
+	}
+	for (i = 0 ; i < num_extensions ; i++) {
+		if (src[i] != -1) {
+			memcpy(ext_md[i], hash_cache[src[i]].md,
+			       sizeof(ext_md[i]));
+		}
+	}
+
+	free(src);
+	free(items);
+}
+
+static void create_cert(int cert_idx)
 {
 	STACK_OF(X509_EXTENSION) * sk;
 	X509_EXTENSION *cert_ext = NULL;
+	cert_t *cert = &certs[cert_idx];
+	unsigned char zero_md[SHA512_DIGEST_LENGTH] = { 0 };
+	unsigned char *md;
+	ext_t *ext;
+	int j, ext_nid, nvctr;
+
+	/* Create a new stack of extensions. This stack will be used
+	 * to create the certificate */
+	CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
+
+	for (j = 0 ; j < cert->num_ext ; j++) {
+
+		ext = &extensions[cert->ext[j]];
+
+		/* Get OpenSSL internal ID for this extension */
+		CHECK_OID(ext_nid, ext->oid);
+
+		/*
+		 * Three types of extensions are currently supported:
+		 *     - EXT_TYPE_NVCOUNTER
+		 *     - EXT_TYPE_HASH
+		 *     - EXT_TYPE_PKEY
+		 */
+		switch (ext->type) {
+		case EXT_TYPE_NVCOUNTER:
+			if (ext->optional && ext->arg == NULL) {
+				/* Skip this NVCounter */
+				continue;
+			} else {
+				/* Checked by `check_cmd_params` */
+				assert(ext->arg != NULL);
+				nvctr = atoi(ext->arg);
+				CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
+					EXT_CRIT, nvctr));
+			}
+			break;
+		case EXT_TYPE_HASH:
+			if (ext->arg == NULL) {
+				if (ext->optional) {
+					/* Include a hash filled with zeros */
+					md = zero_md;
+				} else {
+					/* Do not include this hash in the certificate */
+					continue;
+				}
+			} else {
+				/* Calculated by hash_images() */
+				md = ext_md[cert->ext[j]];
+			}
+			CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
+					EXT_CRIT, md_info, md,
+					md_len));
+			break;
+		case EXT_TYPE_PKEY:
+			CHECK_NULL(cert_ext, ext_new_key(ext_nid,
+				EXT_CRIT, keys[ext->attr.key].key));
+			break;
+		default:
+			ERROR("Unknown extension type '%d' in %s\n",
+					ext->type, cert->cn);
+			exit(1);
+		}
+
+		/* Push the extension into the stack */
+		sk_X509_EXTENSION_push(sk, cert_ext);
+	}
+
+	/* Create certificate. Signed with corresponding key */
+	if (!cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
+		ERROR("Cannot create %s\n", cert->cn);
+		exit(1);
+	}
+
+	for (cert_ext = sk_X509_EXTENSION_pop(sk); cert_ext != NULL;
+			cert_ext = sk_X509_EXTENSION_pop(sk)) {
+		X509_EXTENSION_free(cert_ext);
+	}
+
+	sk_X509_EXTENSION_free(sk);
+}
+
+/*
+ * Create the requested certificates. A certificate issued by another
+ * requested certificate is only created once its issuer exists, all the
+ * certificates whose issuer is available are created in parallel.
+ */
+static void create_certs(void)
+{
+	int *todo, *ready;
+	int num_todo = 0, num_ready;
+	int i, issuer;
+
+	CHECK_NULL(todo, malloc(num_certs * sizeof(*todo)));
+	CHECK_NULL(ready, malloc(num_certs * sizeof(*ready)));
+
+	for (i = 0 ; i < num_certs ; i++) {
+		if (certs[i].fn != NULL) {
+			/* Certificate requested */
+			todo[num_todo++] = i;
+		}
+	}
+
+	while (num_todo > 0) {
+		num_ready = 0;
+		for (i = 0 ; i < num_todo ; ) {
+			issuer = certs[todo[i]].issuer;
+			if ((issuer == todo[i]) || (certs[issuer].fn == NULL) ||
+			    (certs[issuer].x != NULL)) {
+				ready[num_ready++] = todo[i];
+				todo[i] = todo[--num_todo];
+			} else {
+				i++;
+			}
+		}
+
+		if (num_ready == 0) {
+			ERROR("Circular dependency between certificates\n");
+			exit(1);
+		}
+
+		run_jobs(create_cert, ready, num_ready);
+	}
+
+	free(ready);
+	free(todo);
+}
+
+/*
+ * Hash the images, create the requested certificates and save them to their
+ * files.
+ */
+static void create_cert_set(void)
+{
+	FILE *file;
+	int i;
+
+	stage_begin();
+	hash_images();
+	stage_end(STAGE_HASH);
+
+	stage_begin();
+	create_certs();
+	stage_end(STAGE_SIGN);
+
+	/* Print the certificates */
+	if (print_cert) {
+		for (i = 0 ; i < num_certs ; i++) {
+			if (!certs[i].x) {
+				continue;
+			}
+			printf("\n\n=====================================\n\n");
+			X509_print_fp(stdout, certs[i].x);
+		}
+	}
+
+	/* Save created certificates to files */
+	stage_begin();
+	for (i = 0 ; i < num_certs ; i++) {
+		if (certs[i].x && certs[i].fn) {
+			file = fopen(certs[i].fn, "w");
+			if (file != NULL) {
+				i2d_X509_fp(file, certs[i].x);
+				fclose(file);
+			} else {
+				ERROR("Cannot create file %s\n", certs[i].fn);
+			}
+		}
+	}
+	stage_end(STAGE_WRITE);
+}
+
+/*
+ * Create one certificate set for each line of the manifest 'batch_fn'. A line
+ * holds certificate and extension options in the command line syntax. They
+ * are added to the ones given in the command line, which apply to every set.
+ * The keys are only loaded once, so key options are not accepted in the
+ * manifest.
+ */
+static void run_batch(const struct option *cmd_opt, char *const *base_ext_arg,
+		      char *const *base_cert_fn)
+{
+	FILE *manifest;
+	char *line = NULL;
+	size_t line_size = 0;
+	char **set_argv = NULL;
+	int set_argc, max_argc = 0;
+	int num_sets = 0, line_num = 0;
+	int c, i, opt_idx;
+	const char *cur_opt;
+	char *tok;
+	ext_t *ext;
+	cert_t *cert;
+
+	manifest = fopen(batch_fn, "r");
+	if (manifest == NULL) {
+		ERROR("Cannot open manifest %s\n", batch_fn);
+		exit(1);
+	}
+
+	while (getline(&line, &line_size, manifest) != -1) {
+		line_num++;
+
+		/* Split the line into arguments, argv[0] is not parsed */
+		set_argc = 1;
+		for (tok = strtok(line, " \t\r\n"); tok != NULL;
+		     tok = strtok(NULL, " \t\r\n")) {
+			if (set_argc + 1 >= max_argc) {
+				max_argc = (max_argc == 0) ? 32 : max_argc * 2;
+				CHECK_NULL(set_argv, realloc(set_argv,
+					max_argc * sizeof(*set_argv)));
+			}
+			set_argv[set_argc++] = tok;
+		}
+		if ((set_argc == 1) || (set_argv[1][0] == '#')) {
+			/* Empty line or comment */
+			continue;
+		}
+		set_argv[0] = (char *)batch_fn;
+		set_argv[set_argc] = NULL;
+
+		/* Start from the options given in the command line */
+		for (i = 0 ; i < num_extensions ; i++) {
+			free((void *)extensions[i].arg);
+			extensions[i].arg = (base_ext_arg[i] != NULL) ?
+				strdup(base_ext_arg[i]) : NULL;
+		}
+		for (i = 0 ; i < num_certs ; i++) {
+			free((void *)certs[i].fn);
+			certs[i].fn = (base_cert_fn[i] != NULL) ?
+				strdup(base_cert_fn[i]) : NULL;
+			X509_free(certs[i].x);
+			certs[i].x = NULL;
+		}
+
+		optind = 0;
+		while ((c = getopt_long(set_argc, set_argv, "", cmd_opt,
+					&opt_idx)) != -1) {
+			switch (c) {
+			case CMD_OPT_EXT:
+				cur_opt = cmd_opt_get_name(opt_idx);
+				ext = ext_get_by_opt(cur_opt);
+				free((void *)ext->arg);
+				ext->arg = strdup(optarg);
+				break;
+			case CMD_OPT_CERT:
+				cur_opt = cmd_opt_get_name(opt_idx);
+				cert = cert_get_by_opt(cur_opt);
+				free((void *)cert->fn);
+				cert->fn = strdup(optarg);
+				break;
+			default:
+				ERROR("%s:%d: only certificate and image "
+				      "options are supported\n", batch_fn,
+				      line_num);
+				exit(1);
+			}
+		}
+		if (optind != set_argc) {
+			ERROR("%s:%d: unexpected argument '%s'\n", batch_fn,
+			      line_num, set_argv[optind]);
+			exit(1);
+		}
+
+		check_cmd_params();
+		create_cert_set();
+		num_sets++;
+	}
+
+	free(set_argv);
+	free(line);
+	fclose(manifest);
+
+	NOTICE("Created %d certificate sets, %d images hashed, %d reused\n",
+	       num_sets, hash_cache_len, num_hash_reused);
+	for (i = 0 ; i < NUM_STAGES ; i++) {
+		NOTICE("  %-20s %10.1f ms\n", stage_str[i], stage_ms[i]);
+	}
+}
+
+int main(int argc, char *argv[])
+{
 	ext_t *ext;
 	key_t *key;
 	cert_t *cert;
-	FILE *file;
-	int i, j, ext_nid, nvctr;
+	char **base_ext_arg, **base_cert_fn;
+	int i;
 	int c, opt_idx = 0;
 	const struct option *cmd_opt;
 	const char *cur_opt;
 	unsigned int err_code;
-	unsigned char md[SHA512_DIGEST_LENGTH];
-	unsigned int  md_len;
-	const EVP_MD *md_info;
 
 	NOTICE("CoT Generation Tool: %s\n", build_msg);
 	NOTICE("Target platform: %s\n", platform_msg);
@@ -347,7 +846,7 @@ int main(int argc, char *argv[])
 
 	while (1) {
 		/* getopt_long stores the option index here. */
-		c = getopt_long(argc, argv, "a:b:hknps:", cmd_opt, &opt_idx);
+		c = getopt_long(argc, argv, "a:b:hj:km:nps:", cmd_opt, &opt_idx);
 
 		/* Detect the end of the options. */
 		if (c == -1) {
@@ -372,9 +871,19 @@ int main(int argc, char *argv[])
 		case 'h':
 			print_help(argv[0], cmd_opt);
 			exit(0);
+		case 'j':
+			num_jobs = atoi(optarg);
+			if (num_jobs <= 0) {
+				ERROR("Invalid number of jobs '%s'\n", optarg);
+				exit(1);
+			}
+			break;
 		case 'k':
 			save_keys = 1;
 			break;
+		case 'm':
+			batch_fn = optarg;
+			break;
 		case 'n':
 			new_keys = 1;
 			break;
@@ -415,8 +924,10 @@ int main(int argc, char *argv[])
 		key_size = KEY_SIZES[key_alg][0];
 	}
 
-	/* Check command line arguments */
-	check_cmd_params();
+	/* Check command line arguments, the manifest may complete them */
+	if (batch_fn == NULL) {
+		check_cmd_params();
+	}
 
 	/* Indicate SHA as image hash algorithm in the certificate
 	 * extension */
@@ -432,6 +943,7 @@ int main(int argc, char *argv[])
 	}
 
 	/* Load private keys from files (or generate new ones) */
+	stage_begin();
 	for (i = 0 ; i < num_keys ; i++) {
 #if !USING_OPENSSL3
 		if (!key_new(&keys[i])) {
@@ -474,118 +986,35 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	/* Create the certificates */
-	for (i = 0 ; i < num_certs ; i++) {
-
-		cert = &certs[i];
-
-		if (cert->fn == NULL) {
-			/* Certificate not requested. Skip to the next one */
-			continue;
+	stage_end(STAGE_KEYS);
+
+	if (batch_fn != NULL) {
+		/* Keep the command line options as defaults for every set */
+		CHECK_NULL(base_ext_arg, calloc(num_extensions,
+						sizeof(*base_ext_arg)));
+		CHECK_NULL(base_cert_fn, calloc(num_certs,
+						sizeof(*base_cert_fn)));
+		for (i = 0 ; i < num_extensions ; i++) {
+			base_ext_arg[i] = (char *)extensions[i].arg;
+			extensions[i].arg = NULL;
 		}
-
-		/* Create a new stack of extensions. This stack will be used
-		 * to create the certificate */
-		CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
-
-		for (j = 0 ; j < cert->num_ext ; j++) {
-
-			ext = &extensions[cert->ext[j]];
-
-			/* Get OpenSSL internal ID for this extension */
-			CHECK_OID(ext_nid, ext->oid);
-
-			/*
-			 * Three types of extensions are currently supported:
-			 *     - EXT_TYPE_NVCOUNTER
-			 *     - EXT_TYPE_HASH
-			 *     - EXT_TYPE_PKEY
-			 */
-			switch (ext->type) {
-			case EXT_TYPE_NVCOUNTER:
-				if (ext->optional && ext->arg == NULL) {
-					/* Skip this NVCounter */
-					continue;
-				} else {
-					/* Checked by `check_cmd_params` */
-					assert(ext->arg != NULL);
-					nvctr = atoi(ext->arg);
-					CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
-						EXT_CRIT, nvctr));
-				}
-				break;
-			case EXT_TYPE_HASH:
-				if (ext->arg == NULL) {
-					if (ext->optional) {
-						/* Include a hash filled with zeros */
-						memset(md, 0x0, SHA512_DIGEST_LENGTH);
-					} else {
-						/* Do not include this hash in the certificate */
-						continue;
-					}
-				} else {
-					/* Calculate the hash of the file */
-					if (!sha_file(hash_alg, ext->arg, md)) {
-						ERROR("Cannot calculate hash of %s\n",
-							ext->arg);
-						exit(1);
-					}
-				}
-				CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
-						EXT_CRIT, md_info, md,
-						md_len));
-				break;
-			case EXT_TYPE_PKEY:
-				CHECK_NULL(cert_ext, ext_new_key(ext_nid,
-					EXT_CRIT, keys[ext->attr.key].key));
-				break;
-			default:
-				ERROR("Unknown extension type '%d' in %s\n",
-						ext->type, cert->cn);
-				exit(1);
-			}
-
-			/* Push the extension into the stack */
-			sk_X509_EXTENSION_push(sk, cert_ext);
+		for (i = 0 ; i < num_certs ; i++) {
+			base_cert_fn[i] = (char *)certs[i].fn;
+			certs[i].fn = NULL;
 		}
 
-		/* Create certificate. Signed with corresponding key */
-		if (!cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
-			ERROR("Cannot create %s\n", cert->cn);
-			exit(1);
-		}
+		run_batch(cmd_opt, base_ext_arg, base_cert_fn);
 
-		for (cert_ext = sk_X509_EXTENSION_pop(sk); cert_ext != NULL;
-				cert_ext = sk_X509_EXTENSION_pop(sk)) {
-			X509_EXTENSION_free(cert_ext);
+		for (i = 0 ; i < num_extensions ; i++) {
+			free(base_ext_arg[i]);
 		}
-
-		sk_X509_EXTENSION_free(sk);
-	}
-
-
-	/* Print the certificates */
-	if (print_cert) {
 		for (i = 0 ; i < num_certs ; i++) {
-			if (!certs[i].x) {
-				continue;
-			}
-			printf("\n\n=====================================\n\n");
-			X509_print_fp(stdout, certs[i].x);
-		}
-	}
-
-	/* Save created certificates to files */
-	for (i = 0 ; i < num_certs ; i++) {
-		if (certs[i].x && certs[i].fn) {
-			file = fopen(certs[i].fn, "w");
-			if (file != NULL) {
-				i2d_X509_fp(file, certs[i].x);
-				fclose(file);
-			} else {
-				ERROR("Cannot create file %s\n", certs[i].fn);
-			}
+			free(base_cert_fn[i]);
 		}
+		free(base_cert_fn);
+		free(base_ext_arg);
+	} else {
+		create_cert_set();
 	}
 
 	/* Save keys */
@@ -614,5 +1043,8 @@ int main(int argc, char *argv[])
 
 	cert_cleanup();
 
+	free(ext_md);
+	free(hash_cache);
+
 	return 0;
 }
@@ -1,10 +1,12 @@
 /*
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "debug.h"
 #include "key.h"
 #if USING_OPENSSL3
@@ -14,7 +16,7 @@
 #include <openssl/sha.h>
 #endif
 
-#define BUFFER_SIZE	256
+#define BUFFER_SIZE	4096
 
 #if USING_OPENSSL3
 static int get_algorithm_nid(int hash_alg)
@@ -27,11 +29,38 @@ static int get_algorithm_nid(int hash_alg)
 }
 #endif
 
+/*
+ * Map the whole file read-only so that it can be hashed in a single pass.
+ * Returns NULL if the file is empty or cannot be mapped, in which case the
+ * caller falls back to reading it.
+ */
+static void *map_file(FILE *inFile, size_t *size)
+{
+	struct stat st;
+	void *addr;
+
+	if ((fstat(fileno(inFile), &st) != 0) || !S_ISREG(st.st_mode) ||
+	    (st.st_size == 0)) {
+		return NULL;
+	}
+
+	addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+		    fileno(inFile), 0);
+	if (addr == MAP_FAILED) {
+		return NULL;
+	}
+
+	*size = st.st_size;
+	return addr;
+}
+
 int sha_file(int md_alg, const char *filename, unsigned char *md)
 {
 	FILE *inFile;
 	int bytes;
 	unsigned char data[BUFFER_SIZE];
+	void *map;
+	size_t map_size = 0;
 #if USING_OPENSSL3
 	EVP_MD_CTX *mdctx;
 	const EVP_MD *md_type;
@@ -53,10 +82,15 @@ int sha_file(int md_alg, const char *filename, unsigned char *md)
 		return 0;
 	}
 
+	map = map_file(inFile, &map_size);
+
 #if USING_OPENSSL3
 
 	mdctx = EVP_MD_CTX_new();
 	if (mdctx == NULL) {
+		if (map != NULL) {
+			munmap(map, map_size);
+		}
 		fclose(inFile);
 		ERROR("%s(): Could not create EVP MD context\n", __func__);
 		return 0;
@@ -74,16 +108,26 @@ int sha_file(int md_alg, const char *filename, unsigned char *md)
 		goto err;
 	}
 
-	while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-		EVP_DigestUpdate(mdctx, data, bytes);
+	if (map != NULL) {
+		EVP_DigestUpdate(mdctx, map, map_size);
+	} else {
+		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
+			EVP_DigestUpdate(mdctx, data, bytes);
+		}
 	}
 	EVP_DigestFinal_ex(mdctx, md, &total_bytes);
 
+	if (map != NULL) {
+		munmap(map, map_size);
+	}
 	fclose(inFile);
 	EVP_MD_CTX_free(mdctx);
 	return 1;
 
 err:
+	if (map != NULL) {
+		munmap(map, map_size);
+	}
 	fclose(inFile);
 	EVP_MD_CTX_free(mdctx);
 	return 0;
@@ -92,24 +136,39 @@ err:
 
 	if (md_alg == HASH_ALG_SHA384) {
 		SHA384_Init(&sha512Context);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
+		if (map != NULL) {
+			SHA384_Update(&sha512Context, map, map_size);
+		}
+		while ((map == NULL) &&
+		       ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0)) {
 			SHA384_Update(&sha512Context, data, bytes);
 		}
 		SHA384_Final(md, &sha512Context);
 	} else if (md_alg == HASH_ALG_SHA512) {
 		SHA512_Init(&sha512Context);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
+		if (map != NULL) {
+			SHA512_Update(&sha512Context, map, map_size);
+		}
+		while ((map == NULL) &&
+		       ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0)) {
 			SHA512_Update(&sha512Context, data, bytes);
 		}
 		SHA512_Final(md, &sha512Context);
 	} else {
 		SHA256_Init(&shaContext);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
+		if (map != NULL) {
+			SHA256_Update(&shaContext, map, map_size);
+		}
+		while ((map == NULL) &&
+		       ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0)) {
 			SHA256_Update(&shaContext, data, bytes);
 		}
 		SHA256_Final(md, &shaContext);
 	}
 
+	if (map != NULL) {
+		munmap(map, map_size);
+	}
 	fclose(inFile);
 	return 1;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Linaro Limited. All rights reserved.
+ * Copyright (c) 2019-2023, Linaro Limited. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -8,6 +8,7 @@
 #include <firmware_encrypted.h>
 #include <openssl/evp.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "debug.h"
 #include "encrypt.h"
@@ -19,9 +20,83 @@
 #define KEY_SIZE		32
 #define KEY_STRING_SIZE		64
 
+/*
+ * Encrypt each chunk of 'ip_file' as a separate GCM message and write it to
+ * 'op_file' followed by its tag. Returns 1 on success.
+ */
+static int gcm_encrypt_chunks(EVP_CIPHER_CTX *ctx, const unsigned char *key,
+			      const unsigned char *iv, size_t chunk_size,
+			      FILE *ip_file, FILE *op_file)
+{
+	unsigned char *data, *enc_data;
+	unsigned char chunk_iv[IV_SIZE], tag[TAG_SIZE];
+	uint32_t idx = 0;
+	size_t bytes;
+	int enc_len, last, c, ret = 1;
+
+	data = malloc(chunk_size);
+	enc_data = malloc(chunk_size);
+	if ((data == NULL) || (enc_data == NULL)) {
+		ERROR("Cannot allocate chunk buffers\n");
+		ret = -1;
+		goto out;
+	}
+
+	do {
+		bytes = fread(data, 1, chunk_size, ip_file);
+		if (ferror(ip_file)) {
+			ERROR("Cannot read input file\n");
+			ret = -1;
+			goto out;
+		}
+
+		/* The firmware rejects chunked images without any data */
+		if ((idx == 0U) && (bytes == 0U)) {
+			ERROR("Cannot encrypt an empty image in chunks\n");
+			ret = -1;
+			goto out;
+		}
+
+		/* Look ahead to flag the last chunk */
+		c = fgetc(ip_file);
+		last = (c == EOF);
+		if (!last) {
+			ungetc(c, ip_file);
+		}
+
+		fw_enc_chunk_iv(chunk_iv, iv, IV_SIZE, idx, last);
+
+		if ((EVP_EncryptInit_ex(ctx, NULL, NULL, key, chunk_iv) != 1) ||
+		    (EVP_EncryptUpdate(ctx, enc_data, &enc_len, data,
+				       bytes) != 1) ||
+		    (EVP_EncryptFinal_ex(ctx, enc_data + enc_len,
+					 &enc_len) != 1) ||
+		    (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, TAG_SIZE,
+					 tag) != 1)) {
+			ERROR("Chunk %u encryption failed\n", idx);
+			ret = -1;
+			goto out;
+		}
+
+		if ((fwrite(enc_data, 1, bytes, op_file) != bytes) ||
+		    (fwrite(tag, 1, TAG_SIZE, op_file) != TAG_SIZE)) {
+			ERROR("Cannot write output file\n");
+			ret = -1;
+			goto out;
+		}
+
+		idx++;
+	} while (!last);
+
+out:
+	free(enc_data);
+	free(data);
+	return ret;
+}
+
 static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
-		       char *nonce_string, const char *ip_name,
-		       const char *op_name)
+		       char *nonce_string, size_t chunk_size,
+		       const char *ip_name, const char *op_name)
 {
 	FILE *ip_file;
 	FILE *op_file;
@@ -29,10 +104,23 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 	unsigned char data[BUFFER_SIZE], enc_data[BUFFER_SIZE];
 	unsigned char key[KEY_SIZE], iv[IV_SIZE], tag[TAG_SIZE];
 	int bytes, enc_len = 0, i, j, ret = 0;
+	unsigned int chunk_shift = 0;
 	struct fw_enc_hdr header;
 
 	memset(&header, 0, sizeof(struct fw_enc_hdr));
 
+	if (chunk_size != 0) {
+		while ((1UL << chunk_shift) < chunk_size) {
+			chunk_shift++;
+		}
+		if (((1UL << chunk_shift) != chunk_size) ||
+		    (chunk_shift < FW_ENC_CHUNK_SHIFT_MIN) ||
+		    (chunk_shift > FW_ENC_CHUNK_SHIFT_MAX)) {
+			ERROR("Unsupported chunk size: %zu\n", chunk_size);
+			return -1;
+		}
+	}
+
 	if (strlen(key_string) != KEY_STRING_SIZE) {
 		ERROR("Unsupported key size: %lu\n", strlen(key_string));
 		return -1;
@@ -90,6 +178,18 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 		goto out;
 	}
 
+	if (chunk_shift != 0) {
+		ret = gcm_encrypt_chunks(ctx, key, iv, chunk_size, ip_file,
+					 op_file);
+		if (ret != 1) {
+			goto out;
+		}
+
+		/* Each chunk carries its own tag */
+		memset(tag, 0, TAG_SIZE);
+		goto write_header;
+	}
+
 	ret = EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv);
 	if (ret != 1) {
 		ERROR("EVP_EncryptInit_ex failed\n");
@@ -121,8 +221,10 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 		goto out;
 	}
 
+write_header:
 	header.magic = ENC_HEADER_MAGIC;
 	header.flags |= fw_enc_status & FW_ENC_STATUS_FLAG_MASK;
+	header.flags |= chunk_shift << FW_ENC_CHUNK_SHIFT_SHIFT;
 	header.dec_algo = KEY_ALG_GCM;
 	header.iv_len = IV_SIZE;
 	header.tag_len = TAG_SIZE;
@@ -155,12 +257,13 @@ out_file:
 }
 
 int encrypt_file(unsigned short fw_enc_status, int enc_alg, char *key_string,
-		 char *nonce_string, const char *ip_name, const char *op_name)
+		 char *nonce_string, size_t chunk_size, const char *ip_name,
+		 const char *op_name)
 {
 	switch (enc_alg) {
 	case KEY_ALG_GCM:
 		return gcm_encrypt(fw_enc_status, key_string, nonce_string,
-				   ip_name, op_name);
+				   chunk_size, ip_name, op_name);
 	default:
 		return -1;
 	}
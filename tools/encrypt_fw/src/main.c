@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Linaro Limited. All rights reserved.
+ * Copyright (c) 2019-2023, Linaro Limited. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -128,6 +128,11 @@ static const cmd_opt_t common_cmd_opt[] = {
 		{ "out", required_argument, NULL, 'o' },
 		"Encrypted output filename."
 	},
+	{
+		{ "chunk-size", required_argument, NULL, 'c' },
+		"Encrypt the image in chunks of the given size (power of two), " \
+		"each with its own tag (default: 0, single chunk)."
+	},
 };
 
 int main(int argc, char *argv[])
@@ -140,6 +145,8 @@ int main(int argc, char *argv[])
 	char *in_fn = NULL;
 	char *out_fn = NULL;
 	unsigned short fw_enc_status = 0;
+	size_t chunk_size = 0;
+	char *endptr;
 
 	NOTICE("Firmware Encryption Tool: %s\n", build_msg);
 
@@ -156,7 +163,7 @@ int main(int argc, char *argv[])
 
 	while (1) {
 		/* getopt_long stores the option index here. */
-		c = getopt_long(argc, argv, "a:f:hi:k:n:o:", cmd_opt, &opt_idx);
+		c = getopt_long(argc, argv, "a:c:f:hi:k:n:o:", cmd_opt, &opt_idx);
 
 		/* Detect the end of the options. */
 		if (c == -1) {
@@ -171,6 +178,13 @@ int main(int argc, char *argv[])
 				exit(1);
 			}
 			break;
+		case 'c':
+			chunk_size = strtoul(optarg, &endptr, 0);
+			if (*endptr != '\0') {
+				ERROR("Invalid chunk size '%s'\n", optarg);
+				exit(1);
+			}
+			break;
 		case 'f':
 			parse_fw_enc_status_flag(optarg, &fw_enc_status);
 			break;
@@ -216,7 +230,8 @@ int main(int argc, char *argv[])
 		exit(1);
 	}
 
-	ret = encrypt_file(fw_enc_status, key_alg, key, nonce, in_fn, out_fn);
+	ret = encrypt_file(fw_enc_status, key_alg, key, nonce, chunk_size,
+			   in_fn, out_fn);
 
 	CRYPTO_cleanup_all_ex_data();
 
@@ -5,6 +5,7 @@
  */
 
 #ifndef _MSC_VER
+#include <sys/mman.h>
 #include <sys/mount.h>
 #endif
 #include <sys/types.h>
@@ -18,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "fiptool.h"
 #include "tbbr_config.h"
@@ -25,6 +27,9 @@
 #define OPT_TOC_ENTRY 0
 #define OPT_PLAT_TOC_FLAGS 1
 #define OPT_ALIGN 2
+#define OPT_IN_PLACE 3
+
+#define BATCH_LINE_MAX 16384
 
 static int info_cmd(int argc, char *argv[]);
 static void info_usage(int);
@@ -38,6 +43,8 @@ static int remove_cmd(int argc, char *argv[]);
 static void remove_usage(int);
 static int version_cmd(int argc, char *argv[]);
 static void version_usage(int);
+static int batch_cmd(int argc, char *argv[]);
+static void batch_usage(int);
 static int help_cmd(int argc, char *argv[]);
 static void usage(void);
 
@@ -49,6 +56,7 @@ static cmd_t cmds[] = {
 	{ .name = "unpack",  .handler = unpack_cmd,  .usage = unpack_usage  },
 	{ .name = "remove",  .handler = remove_cmd,  .usage = remove_usage  },
 	{ .name = "version", .handler = version_cmd, .usage = version_usage },
+	{ .name = "batch",   .handler = batch_cmd,   .usage = batch_usage   },
 	{ .name = "help",    .handler = help_cmd,    .usage = NULL          },
 };
 
@@ -57,6 +65,11 @@ static size_t nr_image_descs;
 static const uuid_t uuid_null;
 static int verbose;
 
+/* Files mapped by the previous commands of a batch. */
+static image_map_t *map_cache;
+static int map_cache_enabled;
+static size_t nr_map_cache_hits;
+
 static void vlog(int prio, const char *msg, va_list ap)
 {
 	char *prefix[] = { "DEBUG", "WARN", "ERROR" };
@@ -167,15 +180,140 @@ static void set_image_desc_action(image_desc_t *desc, int action,
 		    "failed to allocate memory for argument");
 }
 
+/*
+ * Get a read-only view of a whole file. Regular files and block devices are
+ * mapped so that image data is never copied; anything that cannot be mapped
+ * is read into memory instead.
+ */
+static image_map_t *map_file(const char *filename)
+{
+	struct BLD_PLAT_STAT st;
+	image_map_t *map;
+	FILE *fp;
+	size_t st_size;
+
+	if (map_cache_enabled && stat(filename, &st) == 0) {
+		for (map = map_cache; map != NULL; map = map->next) {
+			if (map->st_dev == st.st_dev &&
+			    map->st_ino == st.st_ino) {
+				map->refcount++;
+				nr_map_cache_hits++;
+				return map;
+			}
+		}
+	}
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (fstat(fileno(fp), &st) == -1)
+		log_err("fstat %s", filename);
+
+	st_size = st.st_size;
+
+#ifdef BLKGETSIZE64
+	if ((st.st_mode & S_IFBLK) != 0)
+		if (ioctl(fileno(fp), BLKGETSIZE64, &st_size) == -1)
+			log_err("ioctl %s", filename);
+#endif
+
+	map = xzalloc(sizeof(*map), "failed to allocate memory for file map");
+	map->size = st_size;
+	map->st_dev = st.st_dev;
+	map->st_ino = st.st_ino;
+	map->refcount = 1;
+
+	/* The cache holds its own reference until the file is written. */
+	if (map_cache_enabled) {
+		map->refcount++;
+		map->next = map_cache;
+		map_cache = map;
+	}
+
+	if (st_size == 0) {
+		fclose(fp);
+		return map;
+	}
+
+#ifndef _MSC_VER
+	map->addr = mmap(NULL, st_size, PROT_READ, MAP_PRIVATE,
+	    fileno(fp), 0);
+	if (map->addr != MAP_FAILED) {
+		map->mapped = 1;
+		fclose(fp);
+		return map;
+	}
+#endif
+
+	map->addr = xmalloc(st_size, "failed to load file into memory");
+	if (fread(map->addr, 1, st_size, fp) != st_size)
+		log_errx("Failed to read %s", filename);
+	fclose(fp);
+	return map;
+}
+
+static void unmap_file(image_map_t *map)
+{
+	assert(map->refcount > 0);
+
+	if (--map->refcount != 0)
+		return;
+#ifndef _MSC_VER
+	if (map->mapped)
+		munmap(map->addr, map->size);
+	else
+#endif
+		free(map->addr);
+	free(map);
+}
+
+/* Drop the cached view of 'filename', which is about to be written. */
+static void map_cache_evict(const char *filename)
+{
+	struct BLD_PLAT_STAT st;
+	image_map_t **p, *map;
+
+	if (map_cache == NULL || stat(filename, &st) == -1)
+		return;
+
+	for (p = &map_cache; *p != NULL; p = &(*p)->next) {
+		map = *p;
+		if (map->st_dev == st.st_dev && map->st_ino == st.st_ino) {
+			*p = map->next;
+			unmap_file(map);
+			return;
+		}
+	}
+}
+
+static void map_cache_flush(void)
+{
+	image_map_t *map;
+
+	while (map_cache != NULL) {
+		map = map_cache;
+		map_cache = map->next;
+		unmap_file(map);
+	}
+}
+
+static void free_image(image_t *image)
+{
+	if (image->map != NULL)
+		unmap_file(image->map);
+	else
+		free(image->buffer);
+	free(image);
+}
+
 static void free_image_desc(image_desc_t *desc)
 {
 	free(desc->name);
 	free(desc->cmdline_name);
 	free(desc->action_arg);
-	if (desc->image) {
-		free(desc->image->buffer);
-		free(desc->image);
-	}
+	if (desc->image)
+		free_image(desc->image);
 	free(desc);
 }
 
@@ -202,6 +340,7 @@ static void free_image_descs(void)
 		nr_image_descs--;
 	}
 	assert(nr_image_descs == 0);
+	image_desc_head = NULL;
 }
 
 static void fill_image_descs(void)
@@ -295,34 +434,17 @@ static void uuid_from_str(uuid_t *u, const char *s)
 
 static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 {
-	struct BLD_PLAT_STAT st;
-	FILE *fp;
+	image_map_t *map;
 	char *buf, *bufend;
 	fip_toc_header_t *toc_header;
 	fip_toc_entry_t *toc_entry;
 	int terminated = 0;
 	size_t st_size;
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
-
-	if (fstat(fileno(fp), &st) == -1)
-		log_err("fstat %s", filename);
-
-	st_size = st.st_size;
-
-#ifdef BLKGETSIZE64
-	if ((st.st_mode & S_IFBLK) != 0)
-		if (ioctl(fileno(fp), BLKGETSIZE64, &st_size) == -1)
-			log_err("ioctl %s", filename);
-#endif
-
-	buf = xmalloc(st_size, "failed to load file into memory");
-	if (fread(buf, 1, st_size, fp) != st_size)
-		log_errx("Failed to read %s", filename);
+	map = map_file(filename);
+	buf = map->addr;
+	st_size = map->size;
 	bufend = buf + st_size;
-	fclose(fp);
 
 	if (st_size < sizeof(fip_toc_header_t))
 		log_errx("FIP %s is truncated", filename);
@@ -355,9 +477,7 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 		image = xzalloc(sizeof(*image),
 		    "failed to allocate memory for image");
 		image->toc_e = *toc_entry;
-		image->buffer = xmalloc(toc_entry->size,
-		    "failed to allocate image buffer, is FIP file corrupted?");
-		/* Overflow checks before memory copy. */
+		/* Overflow checks before referencing the image data. */
 		if (toc_entry->size > (uint64_t)-1 - toc_entry->offset_address)
 			log_errx("FIP %s is corrupted: entry size exceeds 64 bit address space",
 				filename);
@@ -365,8 +485,10 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 			log_errx("FIP %s is corrupted: entry size exceeds FIP file size",
 				filename);
 
-		memcpy(image->buffer, buf + toc_entry->offset_address,
-		    toc_entry->size);
+		/* The image data stays in the FIP file view. */
+		image->buffer = buf + toc_entry->offset_address;
+		image->map = map;
+		map->refcount++;
 
 		/* If this is an unknown image, create a descriptor for it. */
 		desc = lookup_image_desc_from_uuid(&toc_entry->uuid);
@@ -392,41 +514,69 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 	if (terminated == 0)
 		log_errx("FIP %s does not have a ToC terminator entry",
 		    filename);
-	free(buf);
+	unmap_file(map);
 	return 0;
 }
 
 static image_t *read_image_from_file(const uuid_t *uuid, const char *filename)
 {
-	struct BLD_PLAT_STAT st;
 	image_t *image;
-	FILE *fp;
 
 	assert(uuid != NULL);
 	assert(filename != NULL);
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
-
-	if (fstat(fileno(fp), &st) == -1)
-		log_errx("fstat %s", filename);
-
 	image = xzalloc(sizeof(*image), "failed to allocate memory for image");
 	image->toc_e.uuid = *uuid;
-	image->buffer = xmalloc(st.st_size, "failed to allocate image buffer");
-	if (fread(image->buffer, 1, st.st_size, fp) != st.st_size)
-		log_errx("Failed to read %s", filename);
-	image->toc_e.size = st.st_size;
+	image->map = map_file(filename);
+	image->buffer = image->map->addr;
+	image->toc_e.size = image->map->size;
 
-	fclose(fp);
 	return image;
 }
 
+/*
+ * Copy into memory the data of all images that reference 'filename', so
+ * that the file can be overwritten while the images are written out.
+ */
+static void detach_images(const char *filename)
+{
+#ifndef _MSC_VER
+	struct BLD_PLAT_STAT st;
+	image_desc_t *desc;
+#endif
+
+	map_cache_evict(filename);
+
+#ifndef _MSC_VER
+	if (stat(filename, &st) == -1)
+		return;
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image = desc->image;
+		void *buf;
+
+		if (image == NULL || image->map == NULL ||
+		    !image->map->mapped ||
+		    image->map->st_dev != st.st_dev ||
+		    image->map->st_ino != st.st_ino)
+			continue;
+
+		buf = xmalloc(image->toc_e.size,
+		    "failed to allocate image buffer");
+		memcpy(buf, image->buffer, image->toc_e.size);
+		unmap_file(image->map);
+		image->map = NULL;
+		image->buffer = buf;
+	}
+#endif
+}
+
 static int write_image_to_file(const image_t *image, const char *filename)
 {
 	FILE *fp;
 
+	map_cache_evict(filename);
+
 	fp = fopen(filename, "wb");
 	if (fp == NULL)
 		log_err("fopen");
@@ -576,6 +726,9 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 	memset(toc_entry, 0, sizeof(*toc_entry));
 	toc_entry->offset_address = (entry_offset + align - 1) & ~(align - 1);
 
+	/* The output may be one of the files the images are read from. */
+	detach_images(filename);
+
 	/* Generate the FIP file. */
 	fp = fopen(filename, "wb");
 	if (fp == NULL)
@@ -600,12 +753,17 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 		xfwrite(image->buffer, image->toc_e.size, fp, filename);
 	}
 
-	if (fseek(fp, entry_offset, SEEK_SET))
-		log_errx("Failed to set file position");
-
+	/*
+	 * Extend the file up to the aligned end of the FIP. As for the gaps
+	 * between images, the padding is left to the seek so the filesystem
+	 * can keep it sparse.
+	 */
 	pad_size = toc_entry->offset_address - entry_offset;
-	while (pad_size--)
+	if (pad_size != 0) {
+		if (fseek(fp, toc_entry->offset_address - 1, SEEK_SET))
+			log_errx("Failed to set file position");
 		fputc(0x0, fp);
+	}
 
 	free(buf);
 	fclose(fp);
@@ -638,7 +796,7 @@ static void update_fip(void)
 				    desc->cmdline_name,
 				    desc->action_arg);
 			}
-			free(desc->image);
+			free_image(desc->image);
 			desc->image = image;
 		} else {
 			if (verbose)
@@ -649,6 +807,198 @@ static void update_fip(void)
 	}
 }
 
+static void xfseek(FILE *fp, uint64_t offset, const char *filename)
+{
+	if (fseek(fp, offset, SEEK_SET))
+		log_errx("Failed to set file position in %s", filename);
+}
+
+static void xfwrite_zeros(uint64_t size, FILE *fp, const char *filename)
+{
+	static const char zeros[4096];
+
+	while (size != 0) {
+		size_t len = size < sizeof(zeros) ? size : sizeof(zeros);
+
+		xfwrite((void *)zeros, len, fp, filename);
+		size -= len;
+	}
+}
+
+/*
+ * Apply the pending DO_PACK actions directly to the FIP 'filename'. An image
+ * that fits in the space of the one it replaces is written over it, any
+ * other image is appended at the end of the FIP. Only the ToC and the new
+ * image data are written, the rest of the file is left untouched.
+ *
+ * This is not power-fail safe: an image replaced in place is overwritten
+ * while the ToC on disk still points at it, so an interrupted update leaves
+ * that image corrupt.
+ *
+ * Returns 0 on success or -1 if the ToC has no room for the new entries, in
+ * which case the file has not been modified.
+ */
+static int update_fip_in_place(const char *filename, uint64_t toc_flags,
+    unsigned long align)
+{
+	struct BLD_PLAT_STAT st;
+	image_map_t *map;
+	image_desc_t *desc;
+	fip_toc_header_t toc_header;
+	fip_toc_entry_t *toc, *toc_entry;
+	image_t **images;
+	uint64_t *old_size, data_start, data_end, fip_end;
+	size_t nr_entries = 0, nr_toc, nr_updates = 0, i, j;
+	FILE *fp;
+
+	map = map_file(filename);
+
+	/* parse_fip() has already validated the ToC. */
+	toc_header = *(fip_toc_header_t *)map->addr;
+	toc_header.flags = toc_flags;
+	toc_entry = (fip_toc_entry_t *)((fip_toc_header_t *)map->addr + 1);
+	while (memcmp(&toc_entry[nr_entries].uuid, &uuid_null,
+	    sizeof(uuid_t)) != 0)
+		nr_entries++;
+	fip_end = toc_entry[nr_entries].offset_address;
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next)
+		if (desc->action == DO_PACK)
+			nr_updates++;
+
+	toc = xzalloc(sizeof(*toc) * (nr_entries + nr_updates + 1),
+	    "failed to allocate memory for ToC");
+	memcpy(toc, toc_entry, sizeof(*toc) * nr_entries);
+	images = xzalloc(sizeof(*images) * (nr_entries + nr_updates),
+	    "failed to allocate memory for images");
+	old_size = xzalloc(sizeof(*old_size) * (nr_entries + nr_updates),
+	    "failed to allocate memory for images");
+
+	/* The ToC must not grow into the first image. */
+	data_start = fip_end;
+	for (i = 0; i < nr_entries; i++)
+		if (toc[i].offset_address < data_start)
+			data_start = toc[i].offset_address;
+
+	/* Add a ToC entry for each image not yet in the FIP. */
+	nr_toc = nr_entries;
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		if (desc->action != DO_PACK)
+			continue;
+		for (i = 0; i < nr_toc; i++)
+			if (memcmp(&toc[i].uuid, &desc->uuid,
+			    sizeof(uuid_t)) == 0)
+				break;
+		if (i == nr_toc)
+			toc[nr_toc++].uuid = desc->uuid;
+	}
+
+	if (sizeof(fip_toc_header_t) +
+	    sizeof(fip_toc_entry_t) * (nr_toc + 1) > data_start) {
+		free(old_size);
+		free(images);
+		free(toc);
+		unmap_file(map);
+		return -1;
+	}
+
+	/* Lay out the new images. */
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image;
+		uint64_t slot_end;
+
+		if (desc->action != DO_PACK)
+			continue;
+		for (i = 0; i < nr_toc; i++)
+			if (memcmp(&toc[i].uuid, &desc->uuid,
+			    sizeof(uuid_t)) == 0)
+				break;
+		assert(i < nr_toc);
+
+		image = read_image_from_file(&desc->uuid, desc->action_arg);
+		if (images[i] != NULL)
+			free_image(images[i]);
+		images[i] = image;
+
+		/* Space up to the next image or the end of the FIP. */
+		slot_end = fip_end;
+		for (j = 0; j < nr_toc; j++)
+			if (toc[j].offset_address > toc[i].offset_address &&
+			    toc[j].offset_address < slot_end)
+				slot_end = toc[j].offset_address;
+
+		if (i < nr_entries &&
+		    image->toc_e.size <= slot_end - toc[i].offset_address) {
+			if (verbose)
+				log_dbgx("Replacing %s in place at 0x%llX",
+				    desc->cmdline_name,
+				    (unsigned long long)toc[i].offset_address);
+			old_size[i] = toc[i].size;
+		} else {
+			toc[i].offset_address =
+			    (fip_end + align - 1) & ~(align - 1);
+			fip_end = (toc[i].offset_address +
+			    image->toc_e.size + align - 1) & ~(align - 1);
+			old_size[i] = 0;
+			if (verbose)
+				log_dbgx("Appending %s at 0x%llX",
+				    desc->cmdline_name,
+				    (unsigned long long)toc[i].offset_address);
+		}
+		toc[i].size = image->toc_e.size;
+	}
+	toc[nr_toc].offset_address = fip_end;
+
+	if (stat(filename, &st) == -1)
+		log_err("stat %s", filename);
+	if ((st.st_mode & S_IFMT) != S_IFREG && fip_end > map->size)
+		log_errx("Updated FIP does not fit in %s", filename);
+
+	/*
+	 * Write the image data, then the ToC. Appended images only become
+	 * visible once the ToC is written, but images replaced in place are
+	 * overwritten in their live slot.
+	 */
+	fp = fopen(filename, "r+b");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	data_end = map->size;
+	for (i = 0; i < nr_toc; i++) {
+		if (images[i] == NULL)
+			continue;
+		xfseek(fp, toc[i].offset_address, filename);
+		xfwrite(images[i]->buffer, toc[i].size, fp, filename);
+		/* Clear what is left of a larger image replaced in place. */
+		if (old_size[i] > toc[i].size)
+			xfwrite_zeros(old_size[i] - toc[i].size, fp, filename);
+		if (toc[i].offset_address + toc[i].size > data_end)
+			data_end = toc[i].offset_address + toc[i].size;
+		free_image(images[i]);
+	}
+
+	/* Extend the file up to the aligned end of the FIP. */
+	if (fip_end > data_end) {
+		xfseek(fp, fip_end - 1, filename);
+		fputc(0x0, fp);
+	}
+
+	xfseek(fp, 0, filename);
+	xfwrite(&toc_header, sizeof(toc_header), fp, filename);
+	xfwrite(toc, sizeof(*toc) * (nr_toc + 1), fp, filename);
+
+	if (fclose(fp) != 0)
+		log_err("fclose %s", filename);
+
+	map_cache_evict(filename);
+
+	free(old_size);
+	free(images);
+	free(toc);
+	unmap_file(map);
+	return 0;
+}
+
 static void parse_plat_toc_flags(const char *arg, unsigned long long *toc_flags)
 {
 	unsigned long long flags;
@@ -805,6 +1155,7 @@ static int update_cmd(int argc, char *argv[])
 	unsigned long long toc_flags = 0;
 	unsigned long align = 1;
 	int pflag = 0;
+	int in_place = 0;
 
 	if (argc < 2)
 		update_usage(EXIT_FAILURE);
@@ -812,6 +1163,7 @@ static int update_cmd(int argc, char *argv[])
 	opts = fill_common_opts(opts, &nr_opts, required_argument);
 	opts = add_opt(opts, &nr_opts, "align", required_argument, OPT_ALIGN);
 	opts = add_opt(opts, &nr_opts, "blob", required_argument, 'b');
+	opts = add_opt(opts, &nr_opts, "in-place", no_argument, OPT_IN_PLACE);
 	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
 	opts = add_opt(opts, &nr_opts, "plat-toc-flags", required_argument,
 	    OPT_PLAT_TOC_FLAGS);
@@ -861,6 +1213,9 @@ static int update_cmd(int argc, char *argv[])
 		case OPT_ALIGN:
 			align = get_image_align(optarg);
 			break;
+		case OPT_IN_PLACE:
+			in_place = 1;
+			break;
 		case 'o':
 			snprintf(outfile, sizeof(outfile), "%s", optarg);
 			break;
@@ -875,16 +1230,28 @@ static int update_cmd(int argc, char *argv[])
 	if (argc == 0)
 		update_usage(EXIT_SUCCESS);
 
+	if (in_place && outfile[0] != '\0' && strcmp(outfile, argv[0]) != 0)
+		log_errx("--in-place cannot be used with --out");
+
 	if (outfile[0] == '\0')
 		snprintf(outfile, sizeof(outfile), "%s", argv[0]);
 
 	if (access(argv[0], F_OK) == 0)
 		parse_fip(argv[0], &toc_header);
+	else if (in_place)
+		log_errx("--in-place requires an existing FIP %s", argv[0]);
 
 	if (pflag)
 		toc_header.flags &= ~(0xffffULL << 32);
 	toc_flags = (toc_header.flags |= toc_flags);
 
+	if (in_place) {
+		if (update_fip_in_place(argv[0], toc_flags, align) != 0)
+			log_errx("No room in the ToC of %s for the new images, "
+			    "update it without --in-place", argv[0]);
+		return 0;
+	}
+
 	update_fip();
 
 	pack_images(outfile, toc_flags, align);
@@ -900,6 +1267,7 @@ static void update_usage(int exit_status)
 	printf("Options:\n");
 	printf("  --align <value>\t\tEach image is aligned to <value> (default: 1).\n");
 	printf("  --blob uuid=...,file=...\tAdd or update an image with the given UUID pointed to by file.\n");
+	printf("  --in-place\t\t\tOnly write the ToC and the updated images to FIP_FILENAME.\n");
 	printf("  --out FIP_FILENAME\t\tSet an alternative output FIP file.\n");
 	printf("  --plat-toc-flags <value>\t16-bit platform specific flag field occupying bits 32-47 in 64-bit ToC header.\n");
 	printf("\n");
@@ -1150,7 +1518,7 @@ static int remove_cmd(int argc, char *argv[])
 			if (verbose)
 				log_dbgx("Removing %s",
 				    desc->cmdline_name);
-			free(desc->image);
+			free_image(desc->image);
 			desc->image = NULL;
 		} else {
 			log_warnx("%s does not exist in %s",
@@ -1204,6 +1572,98 @@ static void version_usage(int exit_status)
 	exit(exit_status);
 }
 
+static double time_ms(void)
+{
+#ifndef _MSC_VER
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#else
+	return clock() * 1000.0 / CLOCKS_PER_SEC;
+#endif
+}
+
+/*
+ * Run each command listed in a manifest, one per line, as if it was given on
+ * the command line. The input files stay mapped from one command to the next
+ * so that images and FIPs shared by several commands are only loaded once.
+ */
+static int batch_cmd(int argc, char *argv[])
+{
+	char line[BATCH_LINE_MAX];
+	char *cmd_argv[BATCH_LINE_MAX / 2 + 1];
+	int cmd_argc, line_num = 0, nr_cmds = 0, i;
+	double start, cmd_start;
+	FILE *fp;
+	char *p;
+
+	if (argc != 2)
+		batch_usage(EXIT_FAILURE);
+
+	fp = fopen(argv[1], "r");
+	if (fp == NULL)
+		log_err("fopen %s", argv[1]);
+
+	map_cache_enabled = 1;
+	start = time_ms();
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		line_num++;
+		if (strchr(line, '\n') == NULL && !feof(fp))
+			log_errx("%s:%d: Line too long", argv[1], line_num);
+
+		cmd_argc = 0;
+		for (p = strtok(line, " \t\r\n"); p != NULL;
+		     p = strtok(NULL, " \t\r\n"))
+			cmd_argv[cmd_argc++] = p;
+		if (cmd_argc == 0 || cmd_argv[0][0] == '#')
+			continue;
+		cmd_argv[cmd_argc] = NULL;
+
+		for (i = 0; i < NELEM(cmds); i++)
+			if (strcmp(cmds[i].name, cmd_argv[0]) == 0)
+				break;
+		if (i == NELEM(cmds) || cmds[i].handler == batch_cmd)
+			log_errx("%s:%d: Invalid command '%s'", argv[1],
+			    line_num, cmd_argv[0]);
+
+		/* Every command starts with a clean image table. */
+		free_image_descs();
+		fill_image_descs();
+		optind = 0;
+
+		cmd_start = time_ms();
+		if (cmds[i].handler(cmd_argc, cmd_argv) != 0)
+			log_errx("%s:%d: %s failed", argv[1], line_num,
+			    cmd_argv[0]);
+		printf("%s:%d: %s %s: %.1f ms\n", argv[1], line_num,
+		    cmd_argv[0], cmd_argv[cmd_argc - 1],
+		    time_ms() - cmd_start);
+		nr_cmds++;
+	}
+
+	if (ferror(fp))
+		log_err("fgets %s", argv[1]);
+	fclose(fp);
+
+	printf("%d commands, %zu files reused: %.1f ms\n", nr_cmds,
+	    nr_map_cache_hits, time_ms() - start);
+
+	map_cache_flush();
+	map_cache_enabled = 0;
+	return 0;
+}
+
+static void batch_usage(int exit_status)
+{
+	printf("fiptool batch MANIFEST\n");
+	printf("\n");
+	printf("Run the commands listed in MANIFEST, one command and its arguments per line.\n");
+	printf("Empty lines and lines starting with '#' are ignored.\n");
+	exit(exit_status);
+}
+
 static int help_cmd(int argc, char *argv[])
 {
 	int i;
@@ -1235,6 +1695,7 @@ static void usage(void)
 	printf("  unpack\tUnpack images from FIP.\n");
 	printf("  remove\tRemove images from FIP.\n");
 	printf("  version\tShow fiptool version.\n");
+	printf("  batch\t\tRun the commands listed in a manifest.\n");
 	printf("  help\t\tShow help for given command.\n");
 	exit(EXIT_SUCCESS);
 }
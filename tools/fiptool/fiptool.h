@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <sys/types.h>
 
 #include <firmware_image_package.h>
 #include <uuid.h>
@@ -40,9 +41,25 @@ typedef struct image_desc {
 	struct image_desc *next;
 } image_desc_t;
 
+/*
+ * Read-only view of an input file. Images parsed from a FIP or read from a
+ * payload file reference the data in place and hold a reference to the view.
+ * In batch mode the views are also kept on a list for the next commands.
+ */
+typedef struct image_map {
+	void                *addr;
+	size_t               size;
+	int                  mapped;
+	dev_t                st_dev;
+	ino_t                st_ino;
+	unsigned int         refcount;
+	struct image_map    *next;
+} image_map_t;
+
 typedef struct image {
 	struct fip_toc_entry toc_e;
 	void                *buffer;
+	image_map_t         *map;
 } image_t;
 
 typedef struct cmd {
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Compare the imported inflate_fast() (inffast.c) with the one selected by
+ * ZLIB_FAST_INFLATE=1 (tf_inffast.c), on gzip compressed images.
+ *
+ * Each image is decompressed with both implementations, in one go as done by
+ * gunzip(), or in chunks of output as done by the decompression IO driver.
+ * The outputs are checked against each other, and zlib checks the gzip CRC.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "zutil.h"
+#include "inftrees.h"
+#include "inflate.h"
+#include "inffast.h"
+
+#define DEFAULT_ITERATIONS	20
+
+void ZLIB_INTERNAL inflate_fast_stock(z_streamp strm, unsigned start);
+void ZLIB_INTERNAL inflate_fast_wide(z_streamp strm, unsigned start);
+
+typedef void (*inflate_fast_fn)(z_streamp strm, unsigned start);
+
+static const struct {
+	const char *name;
+	inflate_fast_fn fn;
+} impls[] = {
+	{ "inffast.c", inflate_fast_stock },
+	{ "tf_inffast.c", inflate_fast_wide },
+};
+
+#define NR_IMPLS	(sizeof(impls) / sizeof(impls[0]))
+
+static inflate_fast_fn inflate_fast_impl;
+
+/* Called by inflate.c */
+void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start)
+{
+	inflate_fast_impl(strm, start);
+}
+
+static void *bench_zalloc(void *opaque, unsigned int items, unsigned int size)
+{
+	return calloc(items, size);
+}
+
+static void bench_zfree(void *opaque, void *ptr)
+{
+	free(ptr);
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static unsigned char *read_file(const char *filename, size_t *len)
+{
+	unsigned char *buf;
+	FILE *fp;
+	long size;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL) {
+		perror(filename);
+		return NULL;
+	}
+
+	if ((fseek(fp, 0, SEEK_END) != 0) || ((size = ftell(fp)) < 0) ||
+	    (fseek(fp, 0, SEEK_SET) != 0)) {
+		perror(filename);
+		fclose(fp);
+		return NULL;
+	}
+
+	buf = malloc(size);
+	if ((buf == NULL) || (fread(buf, 1, size, fp) != (size_t)size)) {
+		fprintf(stderr, "%s: failed to read file\n", filename);
+		free(buf);
+		fclose(fp);
+		return NULL;
+	}
+
+	fclose(fp);
+	*len = size;
+
+	return buf;
+}
+
+/* Decompress 'in' into 'out', 'chunk' bytes of output at a time (0: all) */
+static int decompress(const unsigned char *in, size_t in_len,
+		      unsigned char *out, size_t out_len, size_t chunk)
+{
+	z_stream stream;
+	size_t done = 0;
+	int zret;
+
+	memset(&stream, 0, sizeof(stream));
+	stream.zalloc = bench_zalloc;
+	stream.zfree = bench_zfree;
+
+	zret = inflateInit(&stream);
+	if (zret != Z_OK) {
+		return zret;
+	}
+
+	stream.next_in = (unsigned char *)in;
+	stream.avail_in = in_len;
+
+	do {
+		size_t n = out_len - done;
+
+		if ((chunk != 0) && (n > chunk)) {
+			n = chunk;
+		}
+
+		stream.next_out = out + done;
+		stream.avail_out = n;
+		zret = inflate(&stream, Z_NO_FLUSH);
+		done += n - stream.avail_out;
+	} while ((zret == Z_OK) && (done < out_len));
+
+	/* Let zlib check the trailer once all the output has been produced */
+	if (zret == Z_OK) {
+		zret = inflate(&stream, Z_NO_FLUSH);
+	}
+
+	inflateEnd(&stream);
+
+	if ((zret != Z_STREAM_END) || (done != out_len)) {
+		return (zret == Z_STREAM_END) ? Z_DATA_ERROR : zret;
+	}
+
+	return Z_OK;
+}
+
+static int bench_file(const char *filename, unsigned int iterations,
+		      size_t chunk)
+{
+	unsigned char *in, *out[NR_IMPLS] = { NULL };
+	double best[NR_IMPLS];
+	size_t in_len, out_len;
+	unsigned int i, j;
+	int ret = -1;
+
+	in = read_file(filename, &in_len);
+	if (in == NULL) {
+		return -1;
+	}
+
+	if ((in_len < 18) || (in[0] != 0x1f) || (in[1] != 0x8b)) {
+		fprintf(stderr, "%s: not a gzip file\n", filename);
+		free(in);
+		return -1;
+	}
+
+	/* ISIZE: uncompressed size modulo 2^32 */
+	out_len = (size_t)in[in_len - 4] | ((size_t)in[in_len - 3] << 8) |
+		  ((size_t)in[in_len - 2] << 16) |
+		  ((size_t)in[in_len - 1] << 24);
+
+	for (i = 0; i < NR_IMPLS; i++) {
+		out[i] = malloc(out_len + 1);
+		if (out[i] == NULL) {
+			fprintf(stderr, "%s: out of memory\n", filename);
+			goto out_free;
+		}
+	}
+
+	for (i = 0; i < NR_IMPLS; i++) {
+		inflate_fast_impl = impls[i].fn;
+		best[i] = 0.0;
+
+		for (j = 0; j < iterations; j++) {
+			double start = now(), t;
+			int zret;
+
+			zret = decompress(in, in_len, out[i], out_len, chunk);
+			t = now() - start;
+			if (zret != Z_OK) {
+				fprintf(stderr, "%s: %s: inflate failed (%d)\n",
+					filename, impls[i].name, zret);
+				goto out_free;
+			}
+
+			if ((j == 0) || (t < best[i])) {
+				best[i] = t;
+			}
+		}
+	}
+
+	for (i = 1; i < NR_IMPLS; i++) {
+		if (memcmp(out[0], out[i], out_len) != 0) {
+			fprintf(stderr, "%s: %s and %s outputs differ\n",
+				filename, impls[0].name, impls[i].name);
+			goto out_free;
+		}
+	}
+
+	printf("%s: %zu -> %zu bytes\n", filename, in_len, out_len);
+	for (i = 0; i < NR_IMPLS; i++) {
+		printf("  %-14s %9.3f ms %9.1f MB/s  x%.2f\n", impls[i].name,
+		       best[i] * 1e3, (double)out_len / best[i] / 1e6,
+		       best[0] / best[i]);
+	}
+
+	ret = 0;
+
+out_free:
+	for (i = 0; i < NR_IMPLS; i++) {
+		free(out[i]);
+	}
+	free(in);
+
+	return ret;
+}
+
+static void usage(const char *prog)
+{
+	printf("usage: %s [-n iterations] [-c chunk] <file.gz>...\n", prog);
+	printf("  -n iterations  Runs per implementation, best is kept "
+	       "(default %d)\n", DEFAULT_ITERATIONS);
+	printf("  -c chunk       Bytes of output per inflate() call "
+	       "(default: whole image)\n");
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int iterations = DEFAULT_ITERATIONS;
+	size_t chunk = 0;
+	int opt, ret = 0;
+
+	while ((opt = getopt(argc, argv, "c:hn:")) != -1) {
+		switch (opt) {
+		case 'c':
+			chunk = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			iterations = strtoul(optarg, NULL, 0);
+			break;
+		case 'h':
+			usage(argv[0]);
+			return 0;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((optind >= argc) || (iterations == 0U)) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	for (; optind < argc; optind++) {
+		if (bench_file(argv[optind], iterations, chunk) != 0) {
+			ret = 1;
+		}
+	}
+
+	return ret;
+}
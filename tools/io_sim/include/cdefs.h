@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* The firmware attribute macros, without the rest of the firmware libc */
+#include "../../../include/lib/libc/cdefs.h"
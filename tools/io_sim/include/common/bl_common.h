@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BL_COMMON_H
+#define BL_COMMON_H
+
+/* Nothing from bl_common.h is used by the simulated IO drivers */
+
+#endif /* BL_COMMON_H */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <cdefs.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* The driver messages go to stderr, the trace is written to stdout */
+extern int io_sim_verbose;
+
+#define ERROR(...)	fprintf(stderr, "ERROR:   " __VA_ARGS__)
+#define NOTICE(...)	fprintf(stderr, "NOTICE:  " __VA_ARGS__)
+#define WARN(...)	fprintf(stderr, "WARNING: " __VA_ARGS__)
+
+#define INFO(...)							\
+	do {								\
+		if (io_sim_verbose != 0) {				\
+			fprintf(stderr, "INFO:    " __VA_ARGS__);	\
+		}							\
+	} while (0)
+
+#define VERBOSE(...)							\
+	do {								\
+		if (io_sim_verbose > 1) {				\
+			fprintf(stderr, "VERBOSE: " __VA_ARGS__);	\
+		}							\
+	} while (0)
+
+#endif /* DEBUG_H */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <string.h>
+
+#include <lib/utils_def.h>
+
+#define zeromem(mem, length)	memset((mem), 0, (length))
+
+#endif /* UTILS_H */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/* IO storage limits of the simulated platform, as on Arm platforms */
+#define MAX_IO_DEVICES		4
+#define MAX_IO_HANDLES		4
+#define MAX_IO_BLOCK_DEVICES	1
+#define MAX_IO_MTD_DEVICES	1
+
+#endif /* PLATFORM_DEF_H */
@@ -0,0 +1,909 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Run the IO storage framework and its FIP, memmap, block and MTD drivers on
+ * the host, to measure the device accesses of an image load sequence.
+ *
+ * A FIP (or a flash image holding one) is loaded from a file, and exposed
+ * through an emulated memory-mapped, block or MTD device. The images are then
+ * loaded as load_image() does in the firmware, through IO policies laid out
+ * as on Arm platforms: each image is checked in the FIP before being opened,
+ * sized, read and closed.
+ *
+ * Every io_open(), io_seek(), io_size(), io_read() and io_close() call is
+ * recorded, including the ones the FIP driver makes on its backend device,
+ * along with the device accesses each call caused. The device accesses are
+ * given a simulated duration: a fixed latency per access plus the transfer
+ * time at the device bandwidth.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <drivers/io/io_block.h>
+#include <drivers/io/io_driver.h>
+#include <drivers/io/io_fip.h>
+#include <drivers/io/io_memmap.h>
+#include <drivers/io/io_mtd.h>
+#include <drivers/io/io_storage.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <tools_share/firmware_image_package.h>
+
+#include "tbbr_config.h"
+
+#define FIP_IMAGE_ID		0U
+
+#define DEFAULT_LATENCY_US	10.0
+#define DEFAULT_BANDWIDTH_MBS	50.0
+#define DEFAULT_BLOCK_SIZE	512U
+#define DEFAULT_ITERATIONS	1U
+#define MTD_ERASE_SIZE		0x10000U
+
+#define MAX_TRACKED_HANDLES	16U
+
+/* Images loaded by BL1 then BL2 on Arm platforms, without TBB */
+static const char * const default_sequence[] = {
+	"fw-config", "tb-fw", "tb-fw-config", "hw-config", "soc-fw",
+	"soc-fw-config", "tos-fw", "tos-fw-config", "nt-fw", "nt-fw-config",
+};
+
+#define DEFAULT_SEQUENCE_LEN \
+	(sizeof(default_sequence) / sizeof(default_sequence[0]))
+
+int io_sim_verbose;
+
+/* Real IO storage functions, wrapped with the linker's --wrap option */
+int __real_io_open(uintptr_t dev_handle, const uintptr_t spec,
+		   uintptr_t *handle);
+int __real_io_seek(uintptr_t handle, io_seek_mode_t mode,
+		   signed long long offset);
+int __real_io_size(uintptr_t handle, size_t *length);
+int __real_io_read(uintptr_t handle, uintptr_t buffer, size_t length,
+		   size_t *length_read);
+int __real_io_close(uintptr_t handle);
+
+int __wrap_io_open(uintptr_t dev_handle, const uintptr_t spec,
+		   uintptr_t *handle);
+int __wrap_io_seek(uintptr_t handle, io_seek_mode_t mode,
+		   signed long long offset);
+int __wrap_io_size(uintptr_t handle, size_t *length);
+int __wrap_io_read(uintptr_t handle, uintptr_t buffer, size_t length,
+		   size_t *length_read);
+int __wrap_io_close(uintptr_t handle);
+
+typedef enum {
+	SIM_DEV_MEMMAP,
+	SIM_DEV_BLOCK,
+	SIM_DEV_MTD,
+} sim_dev_type_t;
+
+/* Emulated storage device */
+static struct {
+	sim_dev_type_t type;
+	unsigned char *data;
+	size_t size;
+	size_t fip_offset;
+	double latency_ns;
+	double ns_per_byte;
+	size_t block_size;
+} dev;
+
+/* Device accesses, and their simulated duration */
+typedef struct {
+	unsigned long ops;
+	unsigned long long bytes;
+	double time_ns;
+} dev_stats_t;
+
+static dev_stats_t dev_stats;
+
+typedef enum {
+	OP_OPEN,
+	OP_SEEK,
+	OP_SIZE,
+	OP_READ,
+	OP_CLOSE,
+	OP_DEV_READ,
+	OP_MAX,
+} trace_op_t;
+
+static const char * const op_names[OP_MAX] = {
+	"open", "seek", "size", "read", "close", "device",
+};
+
+static const char * const type_names[IO_TYPE_MAX] = {
+	[IO_TYPE_INVALID] = "-",
+	[IO_TYPE_SEMIHOSTING] = "sh",
+	[IO_TYPE_MEMMAP] = "memmap",
+	[IO_TYPE_FIRMWARE_IMAGE_PACKAGE] = "fip",
+	[IO_TYPE_BLOCK] = "block",
+	[IO_TYPE_MTD] = "mtd",
+	[IO_TYPE_MMC] = "mmc",
+	[IO_TYPE_ENCRYPTED] = "enc",
+	[IO_TYPE_DECOMPRESS] = "decomp",
+};
+
+/*
+ * One traced call. The device accesses are those made during the call,
+ * including by the calls nested in it.
+ */
+typedef struct {
+	trace_op_t op;
+	io_type_t type;
+	unsigned int depth;
+	unsigned long long offset;
+	size_t length;
+	int result;
+	dev_stats_t dev;
+} trace_rec_t;
+
+static struct {
+	int enabled;
+	unsigned int depth;
+	trace_rec_t *recs;
+	size_t count;
+	size_t alloc;
+} trace;
+
+/* Calls and bytes read per operation and device type */
+static unsigned long op_calls[OP_MAX][IO_TYPE_MAX];
+static unsigned long long op_bytes[OP_MAX][IO_TYPE_MAX];
+
+/* Position of the open handles, to record the offset of the reads */
+static struct {
+	uintptr_t handle;
+	io_type_t type;
+	unsigned long long base;
+	unsigned long long pos;
+} handles[MAX_TRACKED_HANDLES];
+
+static uintptr_t backend_dev_handle;
+static uintptr_t fip_dev_handle;
+static const io_dev_connector_t *backend_dev_con;
+static const io_dev_connector_t *fip_dev_con;
+
+static io_block_spec_t fip_block_spec;
+static io_uuid_spec_t image_uuid_spec;
+
+static unsigned char *block_buffer;
+
+static size_t trace_begin(trace_op_t op, io_type_t type,
+			  unsigned long long offset, size_t length)
+{
+	trace_rec_t *rec;
+
+	if (!trace.enabled) {
+		return 0;
+	}
+
+	if (trace.count == trace.alloc) {
+		trace.alloc = (trace.alloc != 0U) ? (trace.alloc * 2U) : 256U;
+		trace.recs = realloc(trace.recs,
+				     trace.alloc * sizeof(trace_rec_t));
+		if (trace.recs == NULL) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+	}
+
+	rec = &trace.recs[trace.count];
+	memset(rec, 0, sizeof(*rec));
+	rec->op = op;
+	rec->type = type;
+	rec->depth = trace.depth;
+	rec->offset = offset;
+	rec->length = length;
+	rec->dev = dev_stats;
+
+	return trace.count++;
+}
+
+static void trace_end(size_t idx, int result, size_t length)
+{
+	trace_rec_t *rec;
+
+	if (!trace.enabled) {
+		return;
+	}
+
+	rec = &trace.recs[idx];
+	rec->result = result;
+	rec->length = length;
+	rec->dev.ops = dev_stats.ops - rec->dev.ops;
+	rec->dev.bytes = dev_stats.bytes - rec->dev.bytes;
+	rec->dev.time_ns = dev_stats.time_ns - rec->dev.time_ns;
+
+	op_calls[rec->op][rec->type]++;
+	if ((rec->op == OP_READ) || (rec->op == OP_DEV_READ)) {
+		op_bytes[rec->op][rec->type] += length;
+	}
+}
+
+/* Account for a device access, of 'length' bytes at 'offset' in the device */
+static void dev_access(io_type_t type, unsigned long long offset,
+		       size_t length)
+{
+	size_t idx;
+
+	idx = trace_begin(OP_DEV_READ, type, offset, length);
+
+	dev_stats.ops++;
+	dev_stats.bytes += length;
+	dev_stats.time_ns += dev.latency_ns + ((double)length * dev.ns_per_byte);
+
+	trace_end(idx, 0, length);
+}
+
+/* Copy from the device, the parts past the end of the file read as erased */
+static void dev_copy(unsigned long long offset, void *buf, size_t length)
+{
+	size_t n = 0U;
+
+	if (offset < dev.size) {
+		n = dev.size - offset;
+		if (n > length) {
+			n = length;
+		}
+		memcpy(buf, dev.data + offset, n);
+	}
+	memset((unsigned char *)buf + n, 0xff, length - n);
+}
+
+static size_t sim_block_read(int lba, uintptr_t buf, size_t size)
+{
+	unsigned long long offset = (unsigned long long)lba * dev.block_size;
+
+	dev_access(IO_TYPE_BLOCK, offset, size);
+	dev_copy(offset, (void *)buf, size);
+
+	return size;
+}
+
+static int sim_mtd_init(unsigned long long *size, unsigned int *erase_size)
+{
+	*size = dev.size;
+	*erase_size = MTD_ERASE_SIZE;
+
+	return 0;
+}
+
+static int sim_mtd_read(unsigned int offset, uintptr_t buffer, size_t length,
+			size_t *out_length)
+{
+	dev_access(IO_TYPE_MTD, offset, length);
+	dev_copy(offset, (void *)buffer, length);
+	*out_length = length;
+
+	return 0;
+}
+
+static io_block_dev_spec_t block_dev_spec = {
+	.ops = {
+		.read = sim_block_read,
+	},
+};
+
+static io_mtd_dev_spec_t mtd_dev_spec = {
+	.ops = {
+		.init = sim_mtd_init,
+		.read = sim_mtd_read,
+	},
+};
+
+static io_type_t handle_type(uintptr_t handle)
+{
+	const io_entity_t *entity = (const io_entity_t *)handle;
+
+	return entity->dev_handle->funcs->type();
+}
+
+static unsigned int find_handle(uintptr_t handle)
+{
+	unsigned int i;
+
+	for (i = 0U; i < MAX_TRACKED_HANDLES; i++) {
+		if (handles[i].handle == handle) {
+			return i;
+		}
+	}
+
+	fprintf(stderr, "too many open handles\n");
+	exit(1);
+}
+
+int __wrap_io_open(uintptr_t dev_handle, const uintptr_t spec,
+		   uintptr_t *handle)
+{
+	io_type_t type = ((const io_dev_info_t *)dev_handle)->funcs->type();
+	unsigned long long base = 0ULL;
+	unsigned int i;
+	size_t idx;
+	int result;
+
+	/* The backend devices are opened with a region of the device */
+	if (type == IO_TYPE_MEMMAP) {
+		base = ((const io_block_spec_t *)spec)->offset -
+		       (uintptr_t)dev.data;
+	} else if ((type == IO_TYPE_BLOCK) || (type == IO_TYPE_MTD)) {
+		base = ((const io_block_spec_t *)spec)->offset;
+	}
+
+	idx = trace_begin(OP_OPEN, type, base, 0U);
+	trace.depth++;
+	result = __real_io_open(dev_handle, spec, handle);
+	trace.depth--;
+	trace_end(idx, result, 0U);
+
+	if (result == 0) {
+		i = find_handle((uintptr_t)NULL);
+		handles[i].handle = *handle;
+		handles[i].type = type;
+		handles[i].base = base;
+		handles[i].pos = 0ULL;
+	}
+
+	return result;
+}
+
+int __wrap_io_seek(uintptr_t handle, io_seek_mode_t mode,
+		   signed long long offset)
+{
+	unsigned int i = find_handle(handle);
+	size_t idx;
+	int result;
+
+	idx = trace_begin(OP_SEEK, handles[i].type, handles[i].base + offset,
+			  0U);
+	trace.depth++;
+	result = __real_io_seek(handle, mode, offset);
+	trace.depth--;
+	trace_end(idx, result, 0U);
+
+	if ((result == 0) && (mode == IO_SEEK_SET)) {
+		handles[i].pos = offset;
+	} else if ((result == 0) && (mode == IO_SEEK_CUR)) {
+		handles[i].pos += offset;
+	}
+
+	return result;
+}
+
+int __wrap_io_size(uintptr_t handle, size_t *length)
+{
+	unsigned int i = find_handle(handle);
+	size_t idx;
+	int result;
+
+	idx = trace_begin(OP_SIZE, handles[i].type, handles[i].base, 0U);
+	trace.depth++;
+	result = __real_io_size(handle, length);
+	trace.depth--;
+	trace_end(idx, result, (result == 0) ? *length : 0U);
+
+	return result;
+}
+
+int __wrap_io_read(uintptr_t handle, uintptr_t buffer, size_t length,
+		   size_t *length_read)
+{
+	unsigned int i = find_handle(handle);
+	unsigned long long offset = handles[i].base + handles[i].pos;
+	size_t idx;
+	int result;
+
+	idx = trace_begin(OP_READ, handles[i].type, offset, length);
+	trace.depth++;
+	/* The memory-mapped device is accessed by the memmap driver reads */
+	if (handle_type(handle) == IO_TYPE_MEMMAP) {
+		dev_access(IO_TYPE_MEMMAP, offset, length);
+	}
+	result = __real_io_read(handle, buffer, length, length_read);
+	trace.depth--;
+	trace_end(idx, result, (result == 0) ? *length_read : 0U);
+
+	if (result == 0) {
+		handles[i].pos += *length_read;
+	}
+
+	return result;
+}
+
+int __wrap_io_close(uintptr_t handle)
+{
+	unsigned int i = find_handle(handle);
+	size_t idx;
+	int result;
+
+	idx = trace_begin(OP_CLOSE, handles[i].type, handles[i].base, 0U);
+	trace.depth++;
+	result = __real_io_close(handle);
+	trace.depth--;
+	trace_end(idx, result, 0U);
+
+	handles[i].handle = (uintptr_t)NULL;
+
+	return result;
+}
+
+/* As open_memmap() and open_fip() on Arm platforms */
+static int check_backend(const uintptr_t spec)
+{
+	uintptr_t handle;
+	int result;
+
+	result = io_dev_init(backend_dev_handle, (uintptr_t)NULL);
+	if (result == 0) {
+		result = io_open(backend_dev_handle, spec, &handle);
+		if (result == 0) {
+			io_close(handle);
+		}
+	}
+
+	return result;
+}
+
+static int check_fip(const uintptr_t spec)
+{
+	uintptr_t handle;
+	int result;
+
+	result = io_dev_init(fip_dev_handle, (uintptr_t)FIP_IMAGE_ID);
+	if (result == 0) {
+		result = io_open(fip_dev_handle, spec, &handle);
+		if (result == 0) {
+			io_close(handle);
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Image IDs are the index of the image in toc_entries[] plus one, FIP_IMAGE_ID
+ * is the FIP on the backend device.
+ */
+int plat_get_image_source(unsigned int image_id, uintptr_t *dev_handle,
+			  uintptr_t *image_spec)
+{
+	int result;
+
+	if (image_id == FIP_IMAGE_ID) {
+		result = check_backend((uintptr_t)&fip_block_spec);
+		*dev_handle = backend_dev_handle;
+		*image_spec = (uintptr_t)&fip_block_spec;
+	} else {
+		image_uuid_spec.uuid = toc_entries[image_id - 1U].uuid;
+		result = check_fip((uintptr_t)&image_uuid_spec);
+		*dev_handle = fip_dev_handle;
+		*image_spec = (uintptr_t)&image_uuid_spec;
+	}
+
+	return result;
+}
+
+/* As load_image() in common/bl_common.c, returns the image size */
+static int load_image(unsigned int image_id, size_t *image_size)
+{
+	uintptr_t dev_handle;
+	uintptr_t image_handle;
+	uintptr_t image_spec;
+	unsigned char *image_base;
+	size_t bytes_read;
+	int io_result;
+
+	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
+	if (io_result != 0) {
+		return io_result;
+	}
+
+	io_result = io_open(dev_handle, image_spec, &image_handle);
+	if (io_result != 0) {
+		return io_result;
+	}
+
+	io_result = io_size(image_handle, image_size);
+	if ((io_result != 0) || (*image_size == 0U)) {
+		goto exit;
+	}
+
+	image_base = malloc(*image_size);
+	if (image_base == NULL) {
+		io_result = -ENOMEM;
+		goto exit;
+	}
+
+	io_result = io_read(image_handle, (uintptr_t)image_base, *image_size,
+			    &bytes_read);
+	if ((io_result == 0) && (bytes_read < *image_size)) {
+		io_result = -EIO;
+	}
+
+	free(image_base);
+
+exit:
+	(void)io_close(image_handle);
+	(void)io_dev_close(dev_handle);
+
+	return io_result;
+}
+
+static int setup_devices(void)
+{
+	const uintptr_t *backend_spec;
+	int result;
+
+	switch (dev.type) {
+	case SIM_DEV_MEMMAP:
+		result = register_io_dev_memmap(&backend_dev_con);
+		backend_spec = NULL;
+		fip_block_spec.offset = (uintptr_t)dev.data + dev.fip_offset;
+		break;
+	case SIM_DEV_BLOCK:
+		block_buffer = aligned_alloc(dev.block_size, dev.block_size);
+		if (block_buffer == NULL) {
+			return -ENOMEM;
+		}
+		block_dev_spec.buffer.offset = (uintptr_t)block_buffer;
+		block_dev_spec.buffer.length = dev.block_size;
+		block_dev_spec.block_size = dev.block_size;
+		result = register_io_dev_block(&backend_dev_con);
+		backend_spec = (const uintptr_t *)&block_dev_spec;
+		fip_block_spec.offset = dev.fip_offset;
+		break;
+	default:
+		result = register_io_dev_mtd(&backend_dev_con);
+		backend_spec = (const uintptr_t *)&mtd_dev_spec;
+		fip_block_spec.offset = dev.fip_offset;
+		break;
+	}
+	fip_block_spec.length = dev.size - dev.fip_offset;
+	if (dev.type == SIM_DEV_BLOCK) {
+		/* The block device is made of whole blocks */
+		fip_block_spec.length = round_up(fip_block_spec.length,
+						 dev.block_size);
+	}
+
+	if (result == 0) {
+		result = register_io_dev_fip(&fip_dev_con);
+	}
+	if (result == 0) {
+		result = io_dev_open(backend_dev_con, (uintptr_t)backend_spec,
+				     &backend_dev_handle);
+	}
+	if (result == 0) {
+		result = io_dev_open(fip_dev_con, (uintptr_t)NULL,
+				     &fip_dev_handle);
+	}
+
+	return result;
+}
+
+static unsigned char *read_file(const char *filename, size_t *len)
+{
+	unsigned char *buf;
+	FILE *fp;
+	long size;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL) {
+		perror(filename);
+		return NULL;
+	}
+
+	if ((fseek(fp, 0, SEEK_END) != 0) || ((size = ftell(fp)) < 0) ||
+	    (fseek(fp, 0, SEEK_SET) != 0)) {
+		perror(filename);
+		fclose(fp);
+		return NULL;
+	}
+
+	buf = malloc(size);
+	if ((buf == NULL) || (fread(buf, 1, size, fp) != (size_t)size)) {
+		fprintf(stderr, "%s: failed to read file\n", filename);
+		free(buf);
+		fclose(fp);
+		return NULL;
+	}
+
+	fclose(fp);
+	*len = size;
+
+	return buf;
+}
+
+/* Read a load sequence, one image name per line, '#' starts a comment */
+static char **read_sequence(const char *filename, unsigned int *count)
+{
+	char line[128], *name, **seq = NULL;
+	unsigned int n = 0U;
+	FILE *fp;
+
+	fp = fopen(filename, "r");
+	if (fp == NULL) {
+		perror(filename);
+		return NULL;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		line[strcspn(line, "#\r\n")] = '\0';
+		name = strtok(line, " \t");
+		if (name == NULL) {
+			continue;
+		}
+
+		seq = realloc(seq, (n + 1U) * sizeof(char *));
+		if ((seq == NULL) || ((seq[n] = strdup(name)) == NULL)) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+		n++;
+	}
+
+	fclose(fp);
+
+	if (n == 0U) {
+		fprintf(stderr, "%s: no image to load\n", filename);
+		return NULL;
+	}
+	*count = n;
+
+	return seq;
+}
+
+static int image_id_from_name(const char *name)
+{
+	unsigned int i;
+
+	for (i = 0U; toc_entries[i].cmdline_name != NULL; i++) {
+		if (strcmp(toc_entries[i].cmdline_name, name) == 0) {
+			return (int)i + 1;
+		}
+	}
+
+	return -1;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void print_trace(FILE *fp)
+{
+	const trace_rec_t *rec;
+	size_t i;
+
+	fprintf(fp, "# seq op dev offset length result dev_ops dev_us\n");
+	for (i = 0U; i < trace.count; i++) {
+		rec = &trace.recs[i];
+		fprintf(fp, "%6zu %*s%-*s %-6s 0x%08llx %8zu %4d %5lu %10.1f\n",
+			i, (int)(2U * rec->depth), "",
+			(int)(8U - (2U * rec->depth)), op_names[rec->op],
+			type_names[rec->type], rec->offset, rec->length,
+			rec->result, rec->dev.ops, rec->dev.time_ns / 1e3);
+	}
+}
+
+static void print_op_summary(void)
+{
+	unsigned int op, type;
+
+	printf("\n%-8s %-8s %8s %12s\n", "call", "device", "count", "bytes");
+	for (op = 0U; op < OP_MAX; op++) {
+		for (type = 0U; type < IO_TYPE_MAX; type++) {
+			if (op_calls[op][type] == 0UL) {
+				continue;
+			}
+			printf("%-8s %-8s %8lu %12llu\n", op_names[op],
+			       type_names[type], op_calls[op][type],
+			       op_bytes[op][type]);
+		}
+	}
+}
+
+static void usage(const char *prog)
+{
+	printf("usage: %s [options] <fip.bin>\n", prog);
+	printf("  -d device      Emulated device: memmap, block or mtd "
+	       "(default memmap)\n");
+	printf("  -o offset      Offset of the FIP in the file (default 0)\n");
+	printf("  -B size        Block size of the block device (default %u)\n",
+	       DEFAULT_BLOCK_SIZE);
+	printf("  -l latency     Device latency per access in us "
+	       "(default %.1f)\n", DEFAULT_LATENCY_US);
+	printf("  -b bandwidth   Device bandwidth in MB/s (default %.1f)\n",
+	       DEFAULT_BANDWIDTH_MBS);
+	printf("  -s file        Load sequence, one fiptool image name per "
+	       "line\n");
+	printf("                 (default: the images of BL1 and BL2 on Arm "
+	       "platforms)\n");
+	printf("  -t file        Write the IO trace to a file, '-' for stdout\n");
+	printf("  -n iterations  Replay the sequence for host timing "
+	       "(default %u)\n", DEFAULT_ITERATIONS);
+	printf("  -v             Print the driver messages, twice for more\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const char * const *seq = default_sequence;
+	unsigned int seq_len = DEFAULT_SEQUENCE_LEN;
+	unsigned int iterations = DEFAULT_ITERATIONS;
+	const char *trace_file = NULL;
+	double latency_us = DEFAULT_LATENCY_US;
+	double bandwidth = DEFAULT_BANDWIDTH_MBS;
+	double start, best = 0.0, t;
+	unsigned int i, j;
+	size_t image_size;
+	dev_stats_t before;
+	int opt, id, result, ret = 0;
+
+	dev.type = SIM_DEV_MEMMAP;
+	dev.block_size = DEFAULT_BLOCK_SIZE;
+
+	while ((opt = getopt(argc, argv, "B:b:d:hl:n:o:s:t:v")) != -1) {
+		switch (opt) {
+		case 'B':
+			dev.block_size = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			bandwidth = strtod(optarg, NULL);
+			break;
+		case 'd':
+			if (strcmp(optarg, "memmap") == 0) {
+				dev.type = SIM_DEV_MEMMAP;
+			} else if (strcmp(optarg, "block") == 0) {
+				dev.type = SIM_DEV_BLOCK;
+			} else if (strcmp(optarg, "mtd") == 0) {
+				dev.type = SIM_DEV_MTD;
+			} else {
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'l':
+			latency_us = strtod(optarg, NULL);
+			break;
+		case 'n':
+			iterations = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			dev.fip_offset = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seq = (const char * const *)read_sequence(optarg,
+								  &seq_len);
+			if (seq == NULL) {
+				return 1;
+			}
+			break;
+		case 't':
+			trace_file = optarg;
+			break;
+		case 'v':
+			io_sim_verbose++;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return 0;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if ((optind != (argc - 1)) || (iterations == 0U) ||
+	    (bandwidth <= 0.0) || (dev.block_size == 0U) ||
+	    ((dev.block_size & (dev.block_size - 1U)) != 0U)) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	dev.data = read_file(argv[optind], &dev.size);
+	if (dev.data == NULL) {
+		return 1;
+	}
+	if (dev.fip_offset >= dev.size) {
+		fprintf(stderr, "FIP offset past the end of %s\n",
+			argv[optind]);
+		return 1;
+	}
+	if ((dev.type == SIM_DEV_BLOCK) &&
+	    ((dev.fip_offset % dev.block_size) != 0U)) {
+		fprintf(stderr, "FIP offset not aligned to the block size\n");
+		return 1;
+	}
+	dev.latency_ns = latency_us * 1e3;
+	dev.ns_per_byte = 1e3 / bandwidth;
+
+	result = setup_devices();
+	if (result != 0) {
+		fprintf(stderr, "failed to set up the IO devices (%d)\n",
+			result);
+		return 1;
+	}
+
+	for (i = 0U; i < seq_len; i++) {
+		if (image_id_from_name(seq[i]) < 0) {
+			fprintf(stderr, "unknown image '%s'\n", seq[i]);
+			return 1;
+		}
+	}
+
+	/* The first run is traced and reported, the others only timed */
+	printf("%-16s %10s %8s %12s %12s\n", "image", "size", "dev ops",
+	       "dev bytes", "dev time us");
+	trace.enabled = 1;
+	for (j = 0U; j < iterations; j++) {
+		start = now();
+		for (i = 0U; i < seq_len; i++) {
+			id = image_id_from_name(seq[i]);
+			before = dev_stats;
+			image_size = 0U;
+			result = load_image((unsigned int)id, &image_size);
+			if (j != 0U) {
+				continue;
+			}
+
+			if (result == -ENOENT) {
+				printf("%-16s %10s", seq[i], "-");
+			} else if (result != 0) {
+				printf("%-16s %10s", seq[i], "error");
+				ret = 1;
+			} else {
+				printf("%-16s %10zu", seq[i], image_size);
+			}
+			printf(" %8lu %12llu %12.1f\n",
+			       dev_stats.ops - before.ops,
+			       dev_stats.bytes - before.bytes,
+			       (dev_stats.time_ns - before.time_ns) / 1e3);
+		}
+		t = now() - start;
+		if ((j == 0U) || (t < best)) {
+			best = t;
+		}
+
+		if (j == 0U) {
+			printf("%-16s %10s %8lu %12llu %12.1f\n", "total", "",
+			       dev_stats.ops, dev_stats.bytes,
+			       dev_stats.time_ns / 1e3);
+			trace.enabled = 0;
+		}
+	}
+
+	print_op_summary();
+	printf("\nhost time per sequence: %.1f us (best of %u)\n", best * 1e6,
+	       iterations);
+
+	if (trace_file != NULL) {
+		FILE *fp = stdout;
+
+		if (strcmp(trace_file, "-") != 0) {
+			fp = fopen(trace_file, "w");
+			if (fp == NULL) {
+				perror(trace_file);
+				return 1;
+			}
+		} else {
+			printf("\n");
+		}
+		print_trace(fp);
+		if (fp != stdout) {
+			fclose(fp);
+		}
+	}
+
+	return ret;
+}
@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Decode the log buffers of a TF-A build with ENABLE_TOKENIZED_LOG=1.
+
+The log buffers are found by their magic in a raw memory dump, e.g. of the
+trusted SRAM. Tokenized messages are looked up in the .tf_log_fmt sections of
+the ELF files given, which hold the format strings, and formatted as TF-A's
+printf() would have. See common/tf_log.c for the buffer layout.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TF_LOG_BUF_MAGIC = 0x474f4c54
+TF_LOG_TOKEN_PAD = 0x00000000
+TF_LOG_TOKEN_TEXT = 0xffffffff
+TF_LOG_HASH_LEN = 80
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+LOG_PREFIX = {
+    10: "ERROR:   ",
+    20: "NOTICE:  ",
+    30: "WARNING: ",
+    40: "INFO:    ",
+    50: "VERBOSE: ",
+}
+
+# Conversions supported by lib/libc/printf.c
+CONV_RE = re.compile(rb"%(0[0-9]*)?(l|ll|z)?([diuxXpcs%])")
+
+
+def tf_log_hash(fmt):
+    """65599 hash of a format string, as TF_LOG_HASH() in tf_log_token.h"""
+    h = len(fmt)
+    k = 65599
+    for c in fmt[:TF_LOG_HASH_LEN]:
+        h = (h + k * c) & 0xffffffff
+        k = (k * 65599) & 0xffffffff
+    if h in (TF_LOG_TOKEN_PAD, TF_LOG_TOKEN_TEXT):
+        h ^= 1
+    return h
+
+
+class Elf:
+    """Minimal reader of the sections of a 64-bit little-endian ELF file"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 2 or \
+           self.data[5] != 1:
+            raise ValueError("%s: not a 64-bit little-endian ELF file" % path)
+
+        shoff, = struct.unpack_from("<Q", self.data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data,
+                                                        0x3a)
+        hdrs = [struct.unpack_from("<IIQQQQIIQQ", self.data,
+                                   shoff + i * shentsize)
+                for i in range(shnum)]
+        strtab = hdrs[shstrndx]
+
+        self.sections = []
+        for name, stype, flags, addr, offset, size, *_ in hdrs:
+            end = self.data.index(b"\0", strtab[4] + name)
+            self.sections.append({
+                "name": self.data[strtab[4] + name:end].decode(),
+                "type": stype,
+                "flags": flags,
+                "addr": addr,
+                "data": self.data[offset:offset + size]
+                        if stype != SHT_NOBITS else b"",
+            })
+
+    def section(self, name):
+        for sec in self.sections:
+            if sec["name"] == name:
+                return sec["data"]
+        return None
+
+    def read_string(self, addr):
+        """Read a NUL terminated string from the loaded sections"""
+        for sec in self.sections:
+            if (sec["flags"] & SHF_ALLOC) == 0:
+                continue
+            off = addr - sec["addr"]
+            if 0 <= off < len(sec["data"]):
+                end = sec["data"].find(b"\0", off)
+                if end >= 0:
+                    return sec["data"][off:end]
+        return None
+
+
+def load_formats(elfs):
+    """Map the tokens to the format strings of all the ELF files"""
+    formats = {}
+    for elf in elfs:
+        section = elf.section(".tf_log_fmt")
+        if section is None:
+            continue
+        # The strings may be padded with NULs for alignment
+        for fmt in section.split(b"\0"):
+            if fmt:
+                token = tf_log_hash(fmt)
+                other = formats.setdefault(token, fmt)
+                if other != fmt:
+                    print("warning: token 0x%08x: %r and %r collide" %
+                          (token, other, fmt), file=sys.stderr)
+    return formats
+
+
+def format_message(fmt, args, elfs):
+    """Format a message with raw 64-bit arguments as TF-A's printf()"""
+    out = []
+    pos = 0
+    args = list(args)
+
+    def conv(m):
+        pad, length, spec = m.group(1), m.group(2), m.group(3).decode()
+        if spec == "%":
+            return "%"
+        v = args.pop(0) if args else 0
+        if length is None and spec != "p":
+            v &= 0xffffffff
+            if spec in "di" and v & 0x80000000:
+                v -= 1 << 32
+        elif spec in "di" and v & (1 << 63):
+            v -= 1 << 64
+
+        if spec == "c":
+            return chr(v & 0xff)
+        if spec == "s":
+            for elf in elfs:
+                s = elf.read_string(v)
+                if s is not None:
+                    return s.decode(errors="replace")
+            return "<0x%x>" % v
+
+        width = int(pad[1:] or "0") if pad else 0
+        prefix = ""
+        if spec == "p":
+            spec = "x"
+            if v != 0:
+                prefix = "0x"
+                width -= 2
+        if spec in "di" and v < 0:
+            prefix = "-"
+            v = -v
+            width -= 1
+        digits = {"d": "d", "i": "d", "u": "d", "x": "x", "X": "X"}[spec]
+        return prefix + format(v, "0%d%s" % (max(width, 0), digits) if pad
+                               else digits)
+
+    for m in CONV_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()].decode(errors="replace"))
+        out.append(conv(m))
+        pos = m.end()
+    out.append(fmt[pos:].decode(errors="replace"))
+
+    return "".join(out)
+
+
+def decode_buffer(dump, offset, formats, elfs, show_prefix):
+    """Decode the records of the log buffer at 'offset' in the dump"""
+    magic, size, head, tail = struct.unpack_from("<IIII", dump, offset)
+    words = struct.unpack_from("<%dI" % size, dump, offset + 16)
+    lines = []
+
+    # The indexes are 32-bit counters, which may have wrapped
+    left = (head - tail) & 0xffffffff
+    if left > size:
+        raise ValueError("bad head/tail")
+
+    while left != 0:
+        pos = tail % size
+        token, info = words[pos], words[(pos + 1) % size]
+        nwords = info & 0xffff
+        level = info >> 16
+        if pos + 2 + nwords > size or 2 + nwords > left:
+            raise ValueError("bad record at word %d" % pos)
+        payload = words[pos + 2:pos + 2 + nwords]
+        tail += 2 + nwords
+        left -= 2 + nwords
+
+        if token == TF_LOG_TOKEN_PAD:
+            continue
+
+        if token == TF_LOG_TOKEN_TEXT:
+            text = struct.pack("<%dI" % nwords, *payload).split(b"\0")[0]
+            msg = text.decode(errors="replace")
+        elif token in formats:
+            args = [payload[i] | (payload[i + 1] << 32)
+                    for i in range(0, nwords, 2)]
+            msg = format_message(formats[token][1:], args, elfs)
+        else:
+            msg = "<unknown token 0x%08x, args %s>\n" % (token, " ".join(
+                "0x%x" % (payload[i] | (payload[i + 1] << 32))
+                for i in range(0, nwords, 2)))
+
+        # A message may be logged in several parts, e.g. ending with ERROR_NL
+        if show_prefix and msg != "\n":
+            msg = LOG_PREFIX.get(level, "") + msg
+        lines.append(msg)
+
+    return "".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("-e", "--elf", action="append", required=True,
+                        help="ELF file of an image (e.g. bl31.elf), can be "
+                             "given several times")
+    parser.add_argument("-n", "--no-prefix", action="store_true",
+                        help="do not prefix messages with their log level")
+    parser.add_argument("dump", help="raw memory dump holding log buffers")
+    args = parser.parse_args()
+
+    elfs = [Elf(path) for path in args.elf]
+    formats = load_formats(elfs)
+
+    with open(args.dump, "rb") as f:
+        dump = f.read()
+
+    magic = struct.pack("<I", TF_LOG_BUF_MAGIC)
+    offset = dump.find(magic)
+    found = 0
+    while offset >= 0:
+        if offset % 4 == 0 and offset + 16 <= len(dump):
+            size, = struct.unpack_from("<I", dump, offset + 4)
+            if size != 0 and (size & (size - 1)) == 0 and \
+               offset + 16 + 4 * size <= len(dump):
+                try:
+                    text = decode_buffer(dump, offset, formats, elfs,
+                                         not args.no_prefix)
+                except ValueError as e:
+                    print("warning: buffer at 0x%x: %s" % (offset, e),
+                          file=sys.stderr)
+                else:
+                    print("--- log buffer at offset 0x%x ---" % offset)
+                    sys.stdout.write(text)
+                    found += 1
+        offset = dump.find(magic, offset + 1)
+
+    if found == 0:
+        print("error: no log buffer found in %s" % args.dump, file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())